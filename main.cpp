@@ -3,8 +3,14 @@
 #include <string>
 #include <algorithm>
 #include <map>
+#include <cstdint>
+#include <cctype>
+#include <unordered_map>
 using namespace std;
 
+// Name of our own university; students of every other university are external
+const string HOME_UNIVERSITY = "Our University";
+
 // Base class for Person
 class Person {
 protected:
@@ -16,7 +22,7 @@ public:
     Person(const string& first_name, const string& surname, const string& email)
         : first_name(first_name), surname(surname), email(email) {}
 
-    string getEmail() const {
+    const string& getEmail() const {
         return email;
     }
 
@@ -53,22 +59,106 @@ public:
     Student(const string& first_name, const string& surname, const string& email, const string& university, int matriculation_number)
         : Person(first_name, surname, email), university(university), matriculation_number(matriculation_number) {}
 
-    string getUniversity() const {
+    const string& getUniversity() const {
         return university;
     }
 
+    int getMatriculationNumber() const {
+        return matriculation_number;
+    }
+
     void display() const override {
         Person::display();
         cout << "University: " << university << ", Matriculation Number: " << matriculation_number << endl;
     }
 };
 
+// Open-addressing hash index over e-mail addresses (case-insensitive).
+// Slots hold only the hash and the roster position, so lookups never allocate.
+class EmailIndex {
+private:
+    struct Slot {
+        uint64_t hash = 0;
+        int position = -1;  // -1 marks an empty slot
+    };
+
+    vector<Slot> slots_;  // Power-of-two sized, linear probing
+    size_t count_ = 0;
+
+    void place(uint64_t h, int position) {
+        size_t mask = slots_.size() - 1;
+        size_t i = h & mask;
+        while (slots_[i].position >= 0) {
+            i = (i + 1) & mask;
+        }
+        slots_[i].hash = h;
+        slots_[i].position = position;
+    }
+
+    void rehash(size_t capacity) {
+        vector<Slot> old(capacity);
+        old.swap(slots_);
+        for (const auto& slot : old) {
+            if (slot.position >= 0) {
+                place(slot.hash, slot.position);
+            }
+        }
+    }
+
+public:
+    static uint64_t hash(const string& email) {
+        uint64_t h = 14695981039346656037ULL;  // FNV-1a over the lower-cased e-mail
+        for (unsigned char c : email) {
+            h ^= static_cast<unsigned char>(tolower(c));
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    static bool sameEmail(const string& a, const string& b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (tolower(static_cast<unsigned char>(a[i])) != tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Roster position of email, or -1. emailAt(position) returns the e-mail stored there.
+    template <typename EmailAt>
+    int find(const string& email, EmailAt emailAt) const {
+        if (slots_.empty()) {
+            return -1;
+        }
+        uint64_t h = hash(email);
+        size_t mask = slots_.size() - 1;
+        for (size_t i = h & mask; slots_[i].position >= 0; i = (i + 1) & mask) {
+            if (slots_[i].hash == h && sameEmail(emailAt(slots_[i].position), email)) {
+                return slots_[i].position;
+            }
+        }
+        return -1;
+    }
+
+    void insert(const string& email, int position) {
+        if ((count_ + 1) * 2 > slots_.size()) {
+            rehash(slots_.empty() ? 16 : slots_.size() * 2);
+        }
+        place(hash(email), position);
+        ++count_;
+    }
+};
+
 // Course class
 class Course {
 private:
     string name;
     Lecturer lecturer;
     vector<Student> participants;
+    EmailIndex email_index_;  // Hash index over the participants' emails
 
 public:
     static const int MAX_PARTICIPANTS = 10;
@@ -94,11 +184,13 @@ public:
             cout << "Course is already fully booked." << endl;
             return false;
         }
-        if (find_if(participants.begin(), participants.end(),
-                    [&student](const Student& s) { return s.getEmail() == student.getEmail(); }) != participants.end()) {
+        int existing = email_index_.find(student.getEmail(),
+                                         [this](int position) -> const string& { return participants[position].getEmail(); });
+        if (existing >= 0) {
             cout << "A student with this email is already registered in this course." << endl;
             return false;
         }
+        email_index_.insert(student.getEmail(), static_cast<int>(participants.size()));
         participants.push_back(student);
         return true;
     }
@@ -134,6 +226,50 @@ public:
     }
 };
 
+// Registry of all students holding a course, with the number of courses per student.
+// Keyed by email (lookup by matriculation number too), so the external-student
+// limit is enforced across all courses without scanning their rosters.
+class StudentRegistry {
+private:
+    vector<Student> students_;
+    vector<int> course_counts_;                         // Parallel to students_
+    EmailIndex email_index_;                            // Email -> position in students_
+    unordered_map<int, int> by_matriculation_number_;   // Matriculation number -> position in students_
+
+    int findPosition(const string& email) const {
+        return email_index_.find(email, [this](int position) -> const string& { return students_[position].getEmail(); });
+    }
+
+public:
+    static const int MAX_EXTERNAL_COURSES = 1;
+
+    const Student* findByMatriculationNumber(int matriculation_number) const {
+        auto it = by_matriculation_number_.find(matriculation_number);
+        return it != by_matriculation_number_.end() ? &students_[it->second] : nullptr;
+    }
+
+    int getCourseCount(const string& email) const {
+        int position = findPosition(email);
+        return position >= 0 ? course_counts_[position] : 0;
+    }
+
+    bool mayEnroll(const Student& student) const {
+        return student.getUniversity() == HOME_UNIVERSITY || getCourseCount(student.getEmail()) < MAX_EXTERNAL_COURSES;
+    }
+
+    void recordEnrollment(const Student& student) {
+        int position = findPosition(student.getEmail());
+        if (position < 0) {
+            position = static_cast<int>(students_.size());
+            students_.push_back(student);
+            course_counts_.push_back(0);
+            email_index_.insert(student.getEmail(), position);
+            by_matriculation_number_.emplace(student.getMatriculationNumber(), position);
+        }
+        ++course_counts_[position];
+    }
+};
+
 int main() {
     // Sample lecturers
     Lecturer lecturer1("John", "Doe", "john.doe@example.com", "Prof.");
@@ -147,7 +283,7 @@ int main() {
         Course("Software Engineering", lecturer3)
     };
 
-    vector<Student> students;
+    StudentRegistry registry;
 
     while (true) {
         cout << "\nMenu:\n"
@@ -170,7 +306,7 @@ int main() {
             cout << "Enter student's email: ";
             cin >> email;
             cout << "Enter student's university: ";
-            cin >> university;
+            getline(cin >> ws, university); // University names contain spaces
             cout << "Enter student's matriculation number: ";
             cin >> matriculation_number;
 
@@ -189,13 +325,13 @@ int main() {
             }
 
             Course& selected_course = courses[course_index - 1];
-            if (university != "Our University" && new_student.getUniversity() != university) {
+            if (!registry.mayEnroll(new_student)) {
                 cout << "Students from other universities may only take one course." << endl;
                 continue;
             }
 
             if (selected_course.addParticipant(new_student)) {
-                students.push_back(new_student);
+                registry.recordEnrollment(new_student);
                 cout << "Registration successful!" << endl;
             }
         } else if (choice == 2) {
@@ -1,231 +1,4876 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <cctype>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <string_view>
+#include <charconv>
+#include <fstream>
+#include <cstdio>
+#include <deque>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <optional>
+#include <random>
+#include <set>
+#include <map>
+#include <cstdlib>
+#include <new>
+#include <variant>
+#include <cmath>
+#include <tuple>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+// Build with -DREGISTRAR_SELFTEST=1 to let --selftest check that hot paths do not
+// allocate: operator new is then replaced by one that counts each thread's heap
+// allocations. Other builds keep the standard allocator.
+#ifndef REGISTRAR_SELFTEST
+#define REGISTRAR_SELFTEST 0
+#endif
+
+#if REGISTRAR_SELFTEST
+// Heap allocations made by the current thread
+thread_local std::size_t heap_allocation_count = 0;
+
+void* operator new(std::size_t size)
+{
+    ++heap_allocation_count;
+    if (size == 0)
+    {
+        size = 1;
+    }
+    while (true)
+    {
+        if (void* memory = std::malloc(size))
+        {
+            return memory;
+        }
+        // As the standard operator new does: let the new_handler free memory, or give up
+        const std::new_handler handler = std::get_new_handler();
+        if (!handler)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+// GCC inlines these into callers of the replaced operator new and then mistakes the
+// matching free() for a mismatched deallocation
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif // REGISTRAR_SELFTEST
+
+// Text buffer that reports are rendered into and then written out with a single
+// I/O call, instead of flushing line by line. The buffer keeps its capacity after
+// flushing, so one writer can be reused for many reports.
+class ReportWriter
+{
+    public:
+        // Append text
+        ReportWriter& operator<<(std::string_view text)
+        {
+            this->buffer_.append(text.data(), text.size());
+            return *this;
+        }
+
+        // Append a single character
+        ReportWriter& operator<<(char c)
+        {
+            this->buffer_.push_back(c);
+            return *this;
+        }
+
+        // Append an integer in decimal
+        ReportWriter& operator<<(long long value)
+        {
+            char digits[24];
+            char* end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+            this->buffer_.append(digits, end);
+            return *this;
+        }
+
+        ReportWriter& operator<<(int value) { return *this << static_cast<long long>(value); }
+        ReportWriter& operator<<(std::size_t value) { return *this << static_cast<long long>(value); }
+
+        // Rendered text so far
+        std::string_view view() const { return this->buffer_; }
+
+        // Drop the rendered text but keep the allocated capacity
+        void clear() { this->buffer_.clear(); }
+
+        // Write the rendered text to a stream with one write call and clear the buffer
+        void flushTo(std::ostream& out)
+        {
+            out.write(this->buffer_.data(), static_cast<std::streamsize>(this->buffer_.size()));
+            out.flush();
+            this->clear();
+        }
+
+        // Write the rendered text to a file descriptor and clear the buffer
+        bool flushTo(int fd)
+        {
+            std::size_t written = 0;
+            while (written < this->buffer_.size())
+            {
+#ifdef _WIN32
+                const int result = _write(fd, this->buffer_.data() + written, static_cast<unsigned>(this->buffer_.size() - written));
+#else
+                const ssize_t result = ::write(fd, this->buffer_.data() + written, this->buffer_.size() - written);
+#endif
+                if (result <= 0)
+                {
+                    return false;
+                }
+                written += static_cast<std::size_t>(result);
+            }
+            this->clear();
+            return true;
+        }
+
+    private:
+        std::string buffer_; // Rendered text
+};
+
+// Hot-path metrics: event counters and latency histograms, kept per thread so that
+// recording an event is a plain increment of thread-owned memory (no locks, no shared
+// cache lines). Metrics::collect() sums all threads' values on demand.
+// Build with -DREGISTRAR_METRICS=0 to compile the recording out entirely: the
+// REGISTRAR_COUNT and REGISTRAR_TIME macros then expand to nothing.
+#ifndef REGISTRAR_METRICS
+#define REGISTRAR_METRICS 1
+#endif
+
+// Counted events
+enum class MetricCounter
+{
+    ADDED,
+    FULLY_BOOKED,
+    DUPLICATE_EMAIL,
+    EXTERNAL_STUDENT_LIMIT,
+    WAITLISTED,
+    DROPPED,
+    PROMOTED,
+    MENU_REGISTER,
+    MENU_COURSE_DETAILS,
+    MENU_AVAILABLE_SEATS,
+    MENU_END,
+    MENU_METRICS,
+    MENU_DROP,
+    MENU_INVALID,
+    COUNT
+};
+
+// Timed operations
+enum class MetricTimer
+{
+    ADD_PARTICIPANT,
+    RENDER_PARTICIPANTS,
+    RENDER_AVAILABLE_SEATS,
+    MENU_COURSE_DETAILS,
+    MENU_AVAILABLE_SEATS,
+    MENU_END,
+    COUNT
+};
+
+class Metrics
+{
+    public:
+        static const std::size_t COUNTERS = static_cast<std::size_t>(MetricCounter::COUNT);
+        static const std::size_t TIMERS = static_cast<std::size_t>(MetricTimer::COUNT);
+        // Histogram bucket b counts durations below 2^b ns (bucket 0: 0 ns); the last bucket takes the rest
+        static const std::size_t BUCKETS = 40;
+
+        // Sum over all threads
+        struct Totals
+        {
+            std::uint64_t counters[COUNTERS] = {};
+            std::uint64_t buckets[TIMERS][BUCKETS] = {};
+            std::uint64_t samples[TIMERS] = {};
+            std::uint64_t total_ns[TIMERS] = {};
+
+            // Upper bound in ns of the `p` quantile (0 <= p <= 1) of a timer, 0 without samples
+            std::uint64_t percentile(MetricTimer timer, double p) const
+            {
+                const std::size_t t = static_cast<std::size_t>(timer);
+                const std::uint64_t rank = static_cast<std::uint64_t>(p * static_cast<double>(this->samples[t]));
+                std::uint64_t seen = 0;
+                for (std::size_t b = 0; b < BUCKETS && this->samples[t] > 0; ++b)
+                {
+                    seen += this->buckets[t][b];
+                    if (seen > rank)
+                    {
+                        return std::uint64_t(1) << b;
+                    }
+                }
+                return 0;
+            }
+        };
+
+        static void count(MetricCounter counter)
+        {
+            bump(local().counters[static_cast<std::size_t>(counter)], 1);
+        }
+
+        static void record(MetricTimer timer, std::uint64_t nanoseconds)
+        {
+            ThreadMetrics& metrics = local();
+            const std::size_t t = static_cast<std::size_t>(timer);
+            // Bucket = number of significant bits of the duration
+#if defined(__GNUC__) || defined(__clang__)
+            std::size_t bucket = nanoseconds == 0 ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(nanoseconds));
+#else
+            std::size_t bucket = 0;
+            while (bucket < 64 && (nanoseconds >> bucket) != 0)
+            {
+                ++bucket;
+            }
+#endif
+            bump(metrics.buckets[t][std::min(bucket, BUCKETS - 1)], 1);
+            bump(metrics.samples[t], 1);
+            bump(metrics.total_ns[t], nanoseconds);
+        }
+
+        static Totals collect()
+        {
+            Totals totals;
+            std::lock_guard<std::mutex> lock(registryMutex());
+            for (const auto& metrics : threads())
+            {
+                for (std::size_t c = 0; c < COUNTERS; ++c)
+                {
+                    totals.counters[c] += metrics->counters[c].load(std::memory_order_relaxed);
+                }
+                for (std::size_t t = 0; t < TIMERS; ++t)
+                {
+                    for (std::size_t b = 0; b < BUCKETS; ++b)
+                    {
+                        totals.buckets[t][b] += metrics->buckets[t][b].load(std::memory_order_relaxed);
+                    }
+                    totals.samples[t] += metrics->samples[t].load(std::memory_order_relaxed);
+                    totals.total_ns[t] += metrics->total_ns[t].load(std::memory_order_relaxed);
+                }
+            }
+            return totals;
+        }
+
+        static const char* counterName(std::size_t counter)
+        {
+            static const char* const names[COUNTERS] = {
+                "registrations_added", "rejected_fully_booked", "rejected_duplicate_email",
+                "rejected_external_student_limit", "waitlisted", "dropped", "promoted",
+                "menu_register", "menu_course_details", "menu_available_seats", "menu_end",
+                "menu_metrics", "menu_drop", "menu_invalid"};
+            return names[counter];
+        }
+
+        static const char* timerName(std::size_t timer)
+        {
+            static const char* const names[TIMERS] = {
+                "add_participant", "render_participants", "render_available_seats",
+                "menu_course_details", "menu_available_seats", "menu_end"};
+            return names[timer];
+        }
+
+        // One "name value" line per counter, one line with count, mean and percentiles per timer
+        static void writeText(ReportWriter& out)
+        {
+            const Totals totals = collect();
+            for (std::size_t c = 0; c < COUNTERS; ++c)
+            {
+                out << counterName(c) << ' ' << totals.counters[c] << '\n';
+            }
+            for (std::size_t t = 0; t < TIMERS; ++t)
+            {
+                const MetricTimer timer = static_cast<MetricTimer>(t);
+                out << timerName(t) << " count " << totals.samples[t]
+                    << " mean_ns " << (totals.samples[t] ? totals.total_ns[t] / totals.samples[t] : 0)
+                    << " p50_ns " << totals.percentile(timer, 0.5) << " p99_ns " << totals.percentile(timer, 0.99)
+                    << " p999_ns " << totals.percentile(timer, 0.999) << '\n';
+            }
+        }
+
+        // The same values as one JSON object on one line; histograms as bucket arrays
+        static void writeJson(ReportWriter& out)
+        {
+            const Totals totals = collect();
+            out << "{\"counters\":{";
+            for (std::size_t c = 0; c < COUNTERS; ++c)
+            {
+                out << (c ? "," : "") << '"' << counterName(c) << "\":" << totals.counters[c];
+            }
+            out << "},\"timers\":{";
+            for (std::size_t t = 0; t < TIMERS; ++t)
+            {
+                out << (t ? "," : "") << '"' << timerName(t) << "\":{\"count\":" << totals.samples[t]
+                    << ",\"total_ns\":" << totals.total_ns[t] << ",\"buckets_log2_ns\":[";
+                for (std::size_t b = 0; b < BUCKETS; ++b)
+                {
+                    out << (b ? "," : "") << totals.buckets[t][b];
+                }
+                out << "]}";
+            }
+            out << "}}\n";
+        }
+
+    private:
+        // One thread's values. Only the owning thread writes them; collect() may read
+        // them at any time, hence the relaxed atomics.
+        struct ThreadMetrics
+        {
+            std::atomic<std::uint64_t> counters[COUNTERS];
+            std::atomic<std::uint64_t> buckets[TIMERS][BUCKETS];
+            std::atomic<std::uint64_t> samples[TIMERS];
+            std::atomic<std::uint64_t> total_ns[TIMERS];
+        };
+
+        // Single-writer increment: a load and a store, no locked read-modify-write
+        static void bump(std::atomic<std::uint64_t>& value, std::uint64_t amount)
+        {
+            value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+        // The calling thread's values, created on its first event. They are kept after
+        // the thread exits so its events still count.
+        static ThreadMetrics& local()
+        {
+            thread_local ThreadMetrics* metrics = []()
+            {
+                std::lock_guard<std::mutex> lock(registryMutex());
+                threads().push_back(std::unique_ptr<ThreadMetrics>(new ThreadMetrics()));
+                return threads().back().get();
+            }();
+            return *metrics;
+        }
+
+        static std::mutex& registryMutex()
+        {
+            static std::mutex mutex;
+            return mutex;
+        }
+
+        static std::vector<std::unique_ptr<ThreadMetrics>>& threads()
+        {
+            static std::vector<std::unique_ptr<ThreadMetrics>> all;
+            return all;
+        }
+};
+
+// Records the time from construction to destruction with a MetricTimer
+class ScopedMetricTimer
+{
+    public:
+        explicit ScopedMetricTimer(MetricTimer timer) : timer_(timer), start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~ScopedMetricTimer()
+        {
+            const auto elapsed = std::chrono::steady_clock::now() - this->start_;
+            Metrics::record(this->timer_, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+        ScopedMetricTimer(const ScopedMetricTimer&) = delete;
+        ScopedMetricTimer& operator=(const ScopedMetricTimer&) = delete;
+
+    private:
+        MetricTimer timer_;
+        std::chrono::steady_clock::time_point start_;
+};
+
+#if REGISTRAR_METRICS
+#define REGISTRAR_COUNT(counter) Metrics::count(counter)
+#define REGISTRAR_TIME(timer) ScopedMetricTimer registrar_metric_timer(timer)
+#else
+#define REGISTRAR_COUNT(counter) ((void)0)
+#define REGISTRAR_TIME(timer) ((void)0)
+#endif
+
+// Table that maps strings to small dense IDs (0, 1, 2, ...). Useful for values
+// that repeat across many records, such as university names: each record stores
+// a 4-byte ID and equality becomes an integer compare.
+class StringInterner
+{
+    public:
+        // Returned by find() for strings that were never interned
+        static const std::uint32_t NOT_FOUND = 0xFFFFFFFFu;
+
+        // ID of `text`, adding it to the table if it is new
+        std::uint32_t intern(std::string_view text)
+        {
+            auto it = this->ids_.find(text);
+            if (it != this->ids_.end())
+            {
+                return it->second;
+            }
+            const std::uint32_t id = static_cast<std::uint32_t>(this->names_.size());
+            this->names_.emplace_back(text);
+            this->ids_.emplace(this->names_.back(), id);
+            return id;
+        }
+
+        // ID of `text`, or NOT_FOUND
+        std::uint32_t find(std::string_view text) const
+        {
+            auto it = this->ids_.find(text);
+            return it != this->ids_.end() ? it->second : NOT_FOUND;
+        }
+
+        // String for an ID returned by intern()
+        const std::string& name(std::uint32_t id) const { return this->names_[id]; }
+
+        // Number of distinct strings
+        std::size_t size() const { return this->names_.size(); }
+
+    private:
+        std::deque<std::string> names_; // Interned strings by ID (a deque keeps them in place)
+        std::unordered_map<std::string_view, std::uint32_t> ids_; // Views into names_ -> ID
+};
+
+// Interning table shared by everything that stores university names
+StringInterner& universityNames()
+{
+    static StringInterner table;
+    return table;
+}
+
+// Name of our own university; students of every other university are external
+const std::string HOME_UNIVERSITY = "Our University";
+
+// Interned ID of HOME_UNIVERSITY
+std::uint32_t homeUniversityId()
+{
+    static const std::uint32_t id = universityNames().intern(HOME_UNIVERSITY);
+    return id;
+}
 
 // Base class for Person
 class Person
 {
     public:
         // Constructor to initialize a Person with surname, first name, and email
-        Person(const std::string& surname, const std::string& first_name, const std::string& email) :
-                 surname_(surname), first_name_(first_name), email_(email)     
+        // (taken by value and moved, so callers passing temporaries do not copy)
+        Person(std::string surname, std::string first_name, std::string email) :
+                 surname_(std::move(surname)), first_name_(std::move(first_name)), email_(std::move(email))     
+        {
+        }
+
+        virtual ~Person() = default;
+        Person(const Person&) = default;
+        Person(Person&&) noexcept = default;
+        Person& operator=(const Person&) = default;
+        Person& operator=(Person&&) noexcept = default;
+
+        // Getter for surname
+        const std::string& getSurname() const { return this->surname_; }
+        
+        // Getter for first name
+        const std::string& getFirstname() const { return this->first_name_; }
+
+        // Getter for email
+        const std::string& getEmail() const { return this->email_; }
+
+        // Virtual method to render the Person's information into a report
+        virtual void render(ReportWriter& out) const 
+        {
+            out << "Name: " << this->first_name_ << " " << this->surname_ 
+                << ", Email: " << this->email_ << '\n';
+        }
+
+        // Display the Person's information (written with a single I/O call)
+        void display(std::ostream& out = std::cout) const 
+        {
+            static thread_local ReportWriter writer;
+            this->render(writer);
+            writer.flushTo(out);
+        }
+
+    protected:
+        std::string surname_; // Person's surname
+        std::string first_name_; // Person's first name
+        std::string email_; // Person's email address
+};
+
+// Enumeration for academic titles of lecturers
+enum Title
+{
+    DR = 1U,
+    ASSISS_PROF,
+    ASSOC_PROF,
+    PROF
+};
+
+// Derived class for Lecturer, inheriting from Person.
+// Final, so calls through a Lecturer (not a Person) are dispatched statically.
+class Lecturer final : public Person
+{
+    public:
+        // Constructor to initialize a Lecturer with surname, first name, email, and academic title
+        Lecturer(std::string surname, std::string first_name, std::string email, Title academic_title) : 
+                        Person(std::move(surname), std::move(first_name), std::move(email)), academic_title_(academic_title)
+        {
+        }
+
+        // Getter for academic title
+        Title get_academic_title() const
+        {
+            return this->academic_title_;
+        }
+
+        // Overridden render method to include academic title
+        void render(ReportWriter& out) const override 
+        {
+            out << static_cast<int>(this->academic_title_) << " " << this->first_name_ << " " << this->surname_ 
+                << ", Email: " << this->email_ << '\n';
+        }
+
+    private:
+        Title academic_title_; // Lecturer's academic title
+};
+
+// Derived class for Student, inheriting from Person.
+// Final: rosters store Student by value, so render() calls on them are resolved at
+// compile time and can be inlined into the roster loops.
+class Student final : public Person
+{
+    public:
+        // Constructor to initialize a Student with additional matriculation number and university
+        Student(std::string surname, std::string first_name, std::string email, int marticulation_number, std::string_view university) : 
+        Person(std::move(surname), std::move(first_name), std::move(email)), marticulation_number_(marticulation_number),
+        university_id_(universityNames().intern(university))
+        {
+        }
+
+        // Getter for university name
+        const std::string& getUniversity() const { return universityNames().name(this->university_id_); }
+
+        // Getter for the interned university ID
+        std::uint32_t getUniversityId() const { return this->university_id_; }
+
+        // Check if the student belongs to our own university (an integer compare)
+        bool isFromHomeUniversity() const { return this->university_id_ == homeUniversityId(); }
+        
+        // Getter for matriculation number
+        int getMarticulationNumber() const { return this->marticulation_number_; }
+
+        // Overridden render method to include university and matriculation number
+        void render(ReportWriter& out) const override 
+        {
+            Person::render(out);
+            out << "University: " << this->getUniversity() 
+                << ", Matriculation Number: " << this->marticulation_number_ << '\n';
+        }
+
+    private:
+        int marticulation_number_; // Student's matriculation number
+        std::uint32_t university_id_; // Interned name of the university the student is enrolled in
+};
+
+// A person held by value, without a vtable dispatch: mixed lists of lecturers and
+// students use std::visit, which resolves to the concrete (final) render at compile time
+using PersonRecord = std::variant<Lecturer, Student>;
+
+// Render one record of a mixed person list
+inline void renderPerson(const PersonRecord& person, ReportWriter& out)
+{
+    std::visit([&out](const auto& concrete) { concrete.render(out); }, person);
+}
+
+// Render a list of people of one concrete type (Student or Lecturer); the render
+// call is bound statically, so the loop body is inlined
+template <typename ConcretePerson>
+void renderPeople(const std::vector<ConcretePerson>& people, ReportWriter& out)
+{
+    for (const auto& person : people)
+    {
+        person.render(out);
+    }
+}
+
+// Open-addressing hash index over e-mail addresses.
+// Each slot only stores the hash and the roster position of the entry, the e-mail
+// itself is compared against the roster, so lookups never allocate.
+// E-mails are compared case-insensitively ("A@x.org" and "a@x.org" are the same address).
+class EmailIndex
+{
+    public:
+        // ASCII lower case of `c`: what std::tolower does in the "C" locale the program
+        // runs in, without a library call per character
+        static unsigned char lower(unsigned char c)
+        {
+            return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+        }
+
+        // Case-insensitive FNV-1a hash of an e-mail address
+        static std::uint64_t hash(std::string_view email)
         {
+            std::uint64_t h = 14695981039346656037ULL;
+            for (unsigned char c : email)
+            {
+                h ^= lower(c);
+                h *= 1099511628211ULL;
+            }
+            return h;
         }
 
-        // Getter for surname
-        std::string getSurname() const { return this->surname_; }
-        
-        // Getter for first name
-        std::string getFirstname() const { return this->first_name_; }
+        // Case-insensitive comparison of two e-mail addresses
+        static bool sameEmail(std::string_view a, std::string_view b)
+        {
+            if (a.size() != b.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                if (lower(static_cast<unsigned char>(a[i])) != lower(static_cast<unsigned char>(b[i])))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Hash and equality functors with the same case-insensitive rules, for keying
+        // other containers by e-mail
+        struct Hash
+        {
+            std::size_t operator()(std::string_view email) const { return static_cast<std::size_t>(EmailIndex::hash(email)); }
+        };
+        struct Equal
+        {
+            bool operator()(std::string_view a, std::string_view b) const { return EmailIndex::sameEmail(a, b); }
+        };
+
+        // Number of indexed e-mails
+        std::size_t size() const { return this->size_; }
+
+        // Make room for at least `count` e-mails without rehashing
+        void reserve(std::size_t count)
+        {
+            std::size_t wanted = 8;
+            while (wanted < count * 2)
+            {
+                wanted *= 2;
+            }
+            if (wanted > this->slots_.size())
+            {
+                this->rehash(wanted);
+            }
+        }
+
+        // Find the roster position of `email`, or -1 if it is not indexed.
+        // `emailAt(position)` must return the e-mail stored at that roster position.
+        template <typename EmailAt>
+        int find(std::string_view email, EmailAt emailAt) const
+        {
+            if (this->slots_.empty())
+            {
+                return -1;
+            }
+            const std::uint64_t h = hash(email);
+            const std::size_t mask = this->slots_.size() - 1;
+            for (std::size_t i = h & mask; this->slots_[i].position >= 0; i = (i + 1) & mask)
+            {
+                if (this->slots_[i].hash == h && sameEmail(emailAt(this->slots_[i].position), email))
+                {
+                    return this->slots_[i].position;
+                }
+            }
+            return -1;
+        }
+
+        // Index `email` at roster position `position` (the e-mail must not be indexed yet)
+        void insert(std::string_view email, int position)
+        {
+            if ((this->size_ + 1) * 2 > this->slots_.size())
+            {
+                this->rehash(this->slots_.empty() ? 16 : this->slots_.size() * 2);
+            }
+            this->place(hash(email), position);
+            ++this->size_;
+        }
+
+        // Index `email` at roster position `position` unless it is indexed already.
+        // Returns the position it already has, or -1 if it was inserted. Hashes and
+        // probes once, where find() followed by insert() does both twice.
+        template <typename EmailAt>
+        int findOrInsert(std::string_view email, int position, EmailAt emailAt)
+        {
+            if ((this->size_ + 1) * 2 > this->slots_.size())
+            {
+                this->rehash(this->slots_.empty() ? 16 : this->slots_.size() * 2);
+            }
+            const std::uint64_t h = hash(email);
+            const std::size_t mask = this->slots_.size() - 1;
+            std::size_t i = h & mask;
+            for (; this->slots_[i].position >= 0; i = (i + 1) & mask)
+            {
+                if (this->slots_[i].hash == h && sameEmail(emailAt(this->slots_[i].position), email))
+                {
+                    return this->slots_[i].position;
+                }
+            }
+            this->slots_[i].hash = h;
+            this->slots_[i].position = position;
+            ++this->size_;
+            return -1;
+        }
+
+        // Remove the entry of `email` at roster position `position`.
+        // Returns false if there is no such entry.
+        bool erase(std::string_view email, int position)
+        {
+            const std::size_t slot = this->slotOf(hash(email), position);
+            if (slot == NO_SLOT)
+            {
+                return false;
+            }
+            // Backward-shift deletion: pull later entries of the probe run into the gap,
+            // so lookups never need tombstones
+            const std::size_t mask = this->slots_.size() - 1;
+            std::size_t gap = slot;
+            for (std::size_t i = (gap + 1) & mask; this->slots_[i].position >= 0; i = (i + 1) & mask)
+            {
+                const std::size_t home = this->slots_[i].hash & mask;
+                // The entry may move to the gap unless its home slot lies after the gap
+                // (cyclically, between the gap and the entry)
+                const bool home_after_gap = gap <= i ? (gap < home && home <= i) : (gap < home || home <= i);
+                if (!home_after_gap)
+                {
+                    this->slots_[gap] = this->slots_[i];
+                    gap = i;
+                }
+            }
+            this->slots_[gap] = Slot();
+            --this->size_;
+            return true;
+        }
+
+        // Point the entry of `email` at roster position `from` to position `to`
+        // (after the roster moved the e-mail). Returns false if there is no such entry.
+        bool relocate(std::string_view email, int from, int to)
+        {
+            const std::size_t slot = this->slotOf(hash(email), from);
+            if (slot == NO_SLOT)
+            {
+                return false;
+            }
+            this->slots_[slot].position = to;
+            return true;
+        }
+
+    private:
+        static const std::size_t NO_SLOT = static_cast<std::size_t>(-1);
+
+        // Slot holding the entry with hash `h` at roster position `position`, or NO_SLOT
+        std::size_t slotOf(std::uint64_t h, int position) const
+        {
+            if (this->slots_.empty())
+            {
+                return NO_SLOT;
+            }
+            const std::size_t mask = this->slots_.size() - 1;
+            for (std::size_t i = h & mask; this->slots_[i].position >= 0; i = (i + 1) & mask)
+            {
+                if (this->slots_[i].position == position && this->slots_[i].hash == h)
+                {
+                    return i;
+                }
+            }
+            return NO_SLOT;
+        }
+
+        struct Slot
+        {
+            std::uint64_t hash = 0; // Case-insensitive hash of the e-mail
+            int position = -1;      // Roster position, -1 marks an empty slot
+        };
+
+        // Put an entry into the first free slot of its probe sequence
+        void place(std::uint64_t h, int position)
+        {
+            const std::size_t mask = this->slots_.size() - 1;
+            std::size_t i = h & mask;
+            while (this->slots_[i].position >= 0)
+            {
+                i = (i + 1) & mask;
+            }
+            this->slots_[i].hash = h;
+            this->slots_[i].position = position;
+        }
+
+        // Move all entries into a table with `capacity` slots (a power of two)
+        void rehash(std::size_t capacity)
+        {
+            std::vector<Slot> old(capacity);
+            old.swap(this->slots_);
+            for (const auto& slot : old)
+            {
+                if (slot.position >= 0)
+                {
+                    this->place(slot.hash, slot.position);
+                }
+            }
+        }
+
+        std::vector<Slot> slots_; // Power-of-two sized slot table, linear probing
+        std::size_t size_ = 0;    // Number of occupied slots
+};
+
+// Outcome of an attempt to add a participant to a course
+enum class AddResult
+{
+    ADDED,
+    FULLY_BOOKED,
+    DUPLICATE_EMAIL,
+    WAITLISTED // Course was full; the student was queued on its waitlist
+};
+
+// Outcome of Course::dropParticipant
+struct DropResult
+{
+    bool dropped = false; // A participant or waitlist entry with the email was removed
+    bool was_participant = false; // It was a participant, not a waitlist entry
+    const Student* promoted = nullptr; // Waitlisted student who took the free seat, if any
+};
+
+class CourseCatalog;
+
+// Membership of a course in a CourseCatalog. Copying a course does not copy its
+// membership: only the course object held by the catalog reports to it.
+struct CatalogLink
+{
+    CourseCatalog* catalog = nullptr; // Catalog indexing the course, or nullptr
+    std::size_t index = 0; // Position of the course in the catalog
+
+    CatalogLink() = default;
+    CatalogLink(const CatalogLink&) {}
+    CatalogLink& operator=(const CatalogLink&) { return *this; }
+};
+
+// Class for a Course
+class Course
+{
+    public:
+        // Default maximum and minimum number of participants of a course
+        static const int DEFAULT_MAX_PARTICIPANTS = 10;
+        static const int DEFAULT_MIN_PARTICIPANTS = 3;
+
+        // Constructor to initialize a Course with a name, a Lecturer and its seat limits.
+        // Roster storage is reserved for the full capacity up front, so registering
+        // never reallocates (and copies) the participants.
+        Course(std::string name, Lecturer lecturer,
+               int max_participants = DEFAULT_MAX_PARTICIPANTS, int min_participants = DEFAULT_MIN_PARTICIPANTS) :
+                 name_(std::move(name)), lecturer_(std::move(lecturer)), max_participants_(max_participants), min_participants_(min_participants)
+        {
+            this->participants.reserve(max_participants);
+            this->email_index_.reserve(max_participants);
+        }
+
+        // Maximum number of participants (seats) of this course
+        int getMaxParticipants() const { return this->max_participants_; }
+
+        // Minimum number of participants for this course to take place
+        int getMinParticipants() const { return this->min_participants_; }
+
+        // Getter for course name
+        const std::string& getCourseName() const
+        {
+            return this->name_;
+        }
+
+        // Getter for the lecturer's name
+        const std::string& getLecturerName() const
+        {
+            return this->lecturer_.getSurname();
+        }
+
+        // Getter for course name
+        const std::string& getName() const { return this->name_; }
+        
+        // Getter for the Lecturer object
+        const Lecturer& getLecturer() const { return this->lecturer_; }
+        
+        // Getter for the list of participants
+        const std::vector<Student>& getParticipants() const { return participants; }
+
+        // Check if the course is fully booked
+        bool isFullyBooked() const
+        {
+            return participants.size() >= static_cast<std::size_t>(this->max_participants_);
+        }
+
+        // Add a participant to the course without printing anything
+        AddResult tryAddParticipant(const Student& student) { return this->insertParticipant(student); }
+
+        // Add a participant to the course without printing anything, moving the student in
+        AddResult tryAddParticipant(Student&& student) { return this->insertParticipant(std::move(student)); }
+
+        // Add a participant to the course, or put them on the waitlist if it is full
+        AddResult tryAddOrWaitlist(const Student& student) { return this->tryAddOrWaitlist(Student(student)); }
+
+        // Add a participant to the course, or move them onto the waitlist if it is full
+        AddResult tryAddOrWaitlist(Student&& student)
+        {
+            // Check the seats first, so a waitlisted request is not also counted as rejected
+            if (!this->isFullyBooked())
+            {
+                return this->insertParticipant(std::move(student));
+            }
+            if (this->findParticipant(student.getEmail()) >= 0)
+            {
+                REGISTRAR_COUNT(MetricCounter::DUPLICATE_EMAIL);
+                return AddResult::DUPLICATE_EMAIL; // Already has a seat
+            }
+            const std::uint64_t ticket = this->next_ticket_++;
+            if (!this->waitlisted_.emplace(student.getEmail(), ticket).second)
+            {
+                REGISTRAR_COUNT(MetricCounter::DUPLICATE_EMAIL);
+                return AddResult::DUPLICATE_EMAIL; // Already waiting
+            }
+            this->waitlist_.push_back(WaitlistEntry{std::move(student), ticket});
+            REGISTRAR_COUNT(MetricCounter::WAITLISTED);
+            return AddResult::WAITLISTED;
+        }
+
+        // Add a participant to the course (or its waitlist)
+        bool addParticipant(const Student& student)
+        {
+            AddResult result;
+            {
+                REGISTRAR_TIME(MetricTimer::ADD_PARTICIPANT);
+                result = this->tryAddOrWaitlist(student);
+            }
+            return this->reportAdd(result, student);
+        }
+
+        // Add a participant to the course (or its waitlist), moving the student in
+        bool addParticipant(Student&& student)
+        {
+            AddResult result;
+            {
+                REGISTRAR_TIME(MetricTimer::ADD_PARTICIPANT);
+                result = this->tryAddOrWaitlist(std::move(student));
+            }
+            // `student` has been moved into the roster or the waitlist unless it was rejected
+            return this->reportAdd(result, result == AddResult::ADDED ? participants.back()
+                                           : result == AddResult::WAITLISTED ? this->getLastWaitlisted() : student);
+        }
+
+        // Fill this empty course with a roster read back from a snapshot: the `seated`
+        // records take the seats in order and the `waiting` ones (plus any seated record
+        // beyond the capacity) queue up behind them, as if each had been passed to
+        // tryAddOrWaitlist. Records are read-only participant views (getSurname(),
+        // getEmail(), ...); a Student is only built for records that are kept, in place.
+        // The catalog is told about the new participant count once instead of once per
+        // student, and no metrics are counted. Returns the number of students seated;
+        // nothing is loaded unless the course is empty.
+        template <typename Records>
+        std::size_t restoreRoster(const Records& seated, const Records& waiting)
+        {
+            if (!participants.empty() || !this->waitlist_.empty())
+            {
+                return 0;
+            }
+            const auto makeStudent = [](const auto& record)
+            {
+                return Student(std::string(record.getSurname()), std::string(record.getFirstname()), std::string(record.getEmail()),
+                               record.getMarticulationNumber(), record.getUniversity());
+            };
+            for (const Records* records : {&seated, &waiting})
+            {
+                for (const auto record : *records)
+                {
+                    if (!this->isFullyBooked())
+                    {
+                        const int existing = this->email_index_.findOrInsert(record.getEmail(), static_cast<int>(participants.size()),
+                                                                             [this](int position) -> const std::string&
+                        {
+                            return this->participants[position].getEmail();
+                        });
+                        if (existing < 0)
+                        {
+                            participants.push_back(makeStudent(record));
+                        }
+                    }
+                    else
+                    {
+                        Student student = makeStudent(record);
+                        if (this->findParticipant(student.getEmail()) < 0
+                            && this->waitlisted_.emplace(student.getEmail(), this->next_ticket_).second)
+                        {
+                            this->waitlist_.push_back(WaitlistEntry{std::move(student), this->next_ticket_++});
+                        }
+                    }
+                }
+            }
+            this->notifyCatalog(0);
+            return participants.size();
+        }
+
+        // Number of students waiting for a seat
+        std::size_t getWaitlistSize() const { return this->waitlisted_.size(); }
+
+        // The student most recently put on the waitlist (the waitlist must not be empty)
+        const Student& getLastWaitlisted() const { return this->waitlist_.back().student; }
+
+        // 1-based waitlist position of the student with this email, or 0 if not waiting
+        std::size_t getWaitlistPosition(const std::string& email) const
+        {
+            const auto it = this->waitlisted_.find(email);
+            if (it == this->waitlisted_.end())
+            {
+                return 0;
+            }
+            std::size_t position = 0;
+            for (const auto& entry : this->waitlist_)
+            {
+                position += this->isWaiting(entry);
+                if (entry.ticket == it->second)
+                {
+                    break;
+                }
+            }
+            return position;
+        }
+
+        // Call `visit(student)` for every waiting student, in waitlist order
+        template <typename Visitor>
+        void forEachWaitlisted(Visitor&& visit) const
+        {
+            for (const auto& entry : this->waitlist_)
+            {
+                if (this->isWaiting(entry))
+                {
+                    visit(entry.student);
+                }
+            }
+        }
+
+        // Remove the participant or waitlist entry with this email in O(1). The last
+        // participant takes over the dropped one's roster position, so roster order is
+        // registration order only until the first drop. If a seat became
+        // free, the first waitlisted student for whom `may_promote(student)` is true
+        // takes it; students it rejects leave the waitlist. Promotion pops from the
+        // front of the queue and never rescans the roster.
+        template <typename PromotionCheck>
+        DropResult dropParticipant(const std::string& email, PromotionCheck&& may_promote)
+        {
+            DropResult result;
+            const auto waiting = this->waitlisted_.find(email);
+            if (waiting != this->waitlisted_.end())
+            {
+                // The queue entry stays behind and is skipped once it reaches the front,
+                // or removed when the queue is compacted
+                this->waitlisted_.erase(waiting);
+                this->compactWaitlist();
+                result.dropped = true;
+                return result;
+            }
+
+            const int position = this->findParticipant(email);
+            if (position < 0)
+            {
+                return result;
+            }
+            // Swap-and-pop: the last participant moves into the freed position, so no
+            // other Student is shifted; only that one index entry changes
+            const std::size_t old_count = participants.size();
+            const int last = static_cast<int>(old_count) - 1;
+            this->email_index_.erase(participants[position].getEmail(), position);
+            if (position != last)
+            {
+                this->email_index_.relocate(participants[last].getEmail(), last, position);
+                participants[position] = std::move(participants[last]);
+            }
+            participants.pop_back();
+            this->notifyCatalog(old_count);
+            result.dropped = true;
+            result.was_participant = true;
+            REGISTRAR_COUNT(MetricCounter::DROPPED);
+
+            while (!this->waitlist_.empty() && !this->isFullyBooked())
+            {
+                WaitlistEntry entry = std::move(this->waitlist_.front());
+                this->waitlist_.pop_front();
+                if (!this->isWaiting(entry))
+                {
+                    continue; // Left the waitlist earlier
+                }
+                this->waitlisted_.erase(entry.student.getEmail());
+                if (may_promote(static_cast<const Student&>(entry.student))
+                    && this->insertParticipant(std::move(entry.student)) == AddResult::ADDED)
+                {
+                    result.promoted = &participants.back();
+                    REGISTRAR_COUNT(MetricCounter::PROMOTED);
+                }
+            }
+            return result;
+        }
+
+        // Remove the participant or waitlist entry with this email, promoting any waiting student
+        DropResult dropParticipant(const std::string& email)
+        {
+            return this->dropParticipant(email, [](const Student&) { return true; });
+        }
+
+        // Render all participants of the course into a report
+        void renderParticipants(ReportWriter& out) const
+        {
+            REGISTRAR_TIME(MetricTimer::RENDER_PARTICIPANTS);
+            out << "Course: " << this->name_ 
+                << " Lecturer: " << this->lecturer_.getSurname() << '\n';
+            this->lecturer_.render(out);
+
+            if (this->hasFewParticipants()) 
+            {
+                out << "Course will not take place due to insufficient participants.\n";
+            } 
+            else 
+            {
+                out << "Participants:\n";
+                renderPeople(participants, out);
+            }
+        }
+
+        // Render the available seats of the course into a report
+        void renderAvailableSeats(ReportWriter& out) const 
+        {
+            REGISTRAR_TIME(MetricTimer::RENDER_AVAILABLE_SEATS);
+            out << "Course: " << this->name_ << ", Lecturer: ";
+            this->lecturer_.render(out);
+            out << "Available seats: " << (this->max_participants_ - static_cast<int>(participants.size())) << '\n';
+        }
+
+        // Display all participants of the course
+        void displayParticipants(std::ostream& out = std::cout) const
+        {
+            ReportWriter writer;
+            this->renderParticipants(writer);
+            writer.flushTo(out);
+        }
+
+        // Display available seats in the course
+        void displayAvailableSeats(std::ostream& out = std::cout) const 
+        {
+            ReportWriter writer;
+            this->renderAvailableSeats(writer);
+            writer.flushTo(out);
+        }
+
+        // Check if the course has fewer participants than the minimum required
+        bool hasFewParticipants() const 
+        {
+            return participants.size() < static_cast<std::size_t>(this->min_participants_);
+        }
+
+        // Roster position of the participant with this email, or -1 if not registered
+        int findParticipant(const std::string& email) const
+        {
+            return this->email_index_.find(email, [this](int position) -> const std::string&
+            {
+                return this->participants[position].getEmail();
+            });
+        }
+
+    private:
+        friend class CourseCatalog;
+
+        // Tell the catalog (if any) that the participant count changed from `old_count`
+        void notifyCatalog(std::size_t old_count);
+
+        // Shared implementation of both tryAddParticipant overloads
+        template <typename StudentRef>
+        AddResult insertParticipant(StudentRef&& student)
+        {
+            // Check if the course is already fully booked
+            if (isFullyBooked()) 
+            {
+                REGISTRAR_COUNT(MetricCounter::FULLY_BOOKED);
+                return AddResult::FULLY_BOOKED;
+            }
+            
+            // Ensure no duplicate email exists for participants
+            if (this->findParticipant(student.getEmail()) >= 0)
+            {
+                REGISTRAR_COUNT(MetricCounter::DUPLICATE_EMAIL);
+                return AddResult::DUPLICATE_EMAIL;
+            }
+            
+            // Add the student to the participants list
+            this->email_index_.insert(student.getEmail(), static_cast<int>(participants.size()));
+            participants.push_back(std::forward<StudentRef>(student));
+            this->notifyCatalog(participants.size() - 1);
+            REGISTRAR_COUNT(MetricCounter::ADDED);
+            return AddResult::ADDED;
+        }
+
+        // A waitlist entry; `ticket` tells it apart from later entries with the same email
+        struct WaitlistEntry
+        {
+            Student student;
+            std::uint64_t ticket;
+        };
+
+        // True if the entry was not dropped from the waitlist
+        bool isWaiting(const WaitlistEntry& entry) const
+        {
+            const auto it = this->waitlisted_.find(entry.student.getEmail());
+            return it != this->waitlisted_.end() && it->second == entry.ticket;
+        }
+
+        // Remove dropped entries from the queue once they outnumber the waiting students,
+        // so walking the waitlist stays proportional to its size
+        void compactWaitlist()
+        {
+            const std::size_t waiting = this->waitlisted_.size();
+            if (this->waitlist_.size() - waiting <= waiting)
+            {
+                return;
+            }
+            this->waitlist_.erase(std::remove_if(this->waitlist_.begin(), this->waitlist_.end(),
+                                                 [this](const WaitlistEntry& entry) { return !this->isWaiting(entry); }),
+                                  this->waitlist_.end());
+        }
+
+        // Print the outcome of adding `student`
+        bool reportAdd(AddResult result, const Student& student) const
+        {
+            if (result == AddResult::FULLY_BOOKED) 
+            {
+                std::cout << "Course is already fully booked." << std::endl;
+                return false;
+            }
+            if (result == AddResult::WAITLISTED)
+            {
+                std::cout << "Course is already fully booked. The Student with email: " << student.getEmail()
+                          << " is number " << this->getWaitlistSize() << " on the waitlist." << std::endl;
+                return false;
+            }
+            if (result == AddResult::DUPLICATE_EMAIL)
+            {
+                return false;
+            }
+            std::cout << "The Student with email: " << student.getEmail() 
+                      << " was successfully added! " << std::endl;
+            return true;
+        }
+
+        std::string name_; // Name of the course
+        Lecturer lecturer_; // Lecturer for the course
+        int max_participants_; // Seats of the course
+        int min_participants_; // Participants needed for the course to take place
+        std::vector<Student> participants; // List of participants in the course
+        EmailIndex email_index_; // Hash index over the participants' emails
+        CatalogLink catalog_link_; // Catalog to keep informed about enrollment changes
+        std::deque<WaitlistEntry> waitlist_; // Students waiting for a seat, first come first served
+        // Email (matched ignoring case, like the roster) -> ticket of its live waitlist entry
+        std::unordered_map<std::string, std::uint64_t, EmailIndex::Hash, EmailIndex::Equal> waitlisted_;
+        std::uint64_t next_ticket_ = 0; // Ticket of the next waitlist entry
+};
+
+// The set of courses on offer, plus indices that Course::addParticipant keeps up to
+// date, so "courses with available seats" and "courses below the minimum" are
+// answered in time proportional to the result instead of scanning the catalog:
+//
+//     available_       courses that are not fully booked, in catalog order
+//     under_minimum_   courses below their minimum participant count, in catalog order
+//     by_free_seats_   free seat count -> courses with exactly that many free seats
+//
+// Courses must not be added or removed once the catalog exists.
+class CourseCatalog
+{
+    public:
+        // Take over the courses and index them
+        explicit CourseCatalog(std::vector<Course> courses) : courses_(std::move(courses))
+        {
+            for (std::size_t i = 0; i < this->courses_.size(); ++i)
+            {
+                this->courses_[i].catalog_link_.catalog = this;
+                this->courses_[i].catalog_link_.index = i;
+                this->indexCourse(i, this->courses_[i].participants.size());
+            }
+        }
+
+        CourseCatalog(const CourseCatalog&) = delete;
+        CourseCatalog& operator=(const CourseCatalog&) = delete;
+
+        // Number of courses
+        std::size_t size() const { return this->courses_.size(); }
+
+        // Course at catalog position `index`
+        Course& operator[](std::size_t index) { return this->courses_[index]; }
+        const Course& operator[](std::size_t index) const { return this->courses_[index]; }
+
+        // Iteration over all courses in catalog order
+        std::vector<Course>::iterator begin() { return this->courses_.begin(); }
+        std::vector<Course>::iterator end() { return this->courses_.end(); }
+        std::vector<Course>::const_iterator begin() const { return this->courses_.begin(); }
+        std::vector<Course>::const_iterator end() const { return this->courses_.end(); }
+
+        // Positions of the courses that are not fully booked
+        const std::set<std::size_t>& coursesWithAvailableSeats() const { return this->available_; }
+
+        // Positions of the courses with fewer participants than the minimum
+        const std::set<std::size_t>& coursesUnderMinimum() const { return this->under_minimum_; }
+
+        // Positions of the courses with at least `seats` free seats, most free seats first
+        std::vector<std::size_t> coursesWithFreeSeats(int seats) const
+        {
+            std::vector<std::size_t> result;
+            for (auto it = this->by_free_seats_.rbegin(); it != this->by_free_seats_.rend() && it->first >= seats; ++it)
+            {
+                result.insert(result.end(), it->second.begin(), it->second.end());
+            }
+            return result;
+        }
+
+    private:
+        friend class Course;
+
+        // Add course `index` with `count` participants to the indices
+        void indexCourse(std::size_t index, std::size_t count)
+        {
+            const int free_seats = this->courses_[index].getMaxParticipants() - static_cast<int>(count);
+            if (free_seats > 0)
+            {
+                this->available_.insert(index);
+                this->by_free_seats_[free_seats].insert(index);
+            }
+            if (count < static_cast<std::size_t>(this->courses_[index].getMinParticipants()))
+            {
+                this->under_minimum_.insert(index);
+            }
+        }
+
+        // Remove course `index` with `count` participants from the indices
+        void unindexCourse(std::size_t index, std::size_t count)
+        {
+            const int free_seats = this->courses_[index].getMaxParticipants() - static_cast<int>(count);
+            if (free_seats > 0)
+            {
+                this->available_.erase(index);
+                auto bucket = this->by_free_seats_.find(free_seats);
+                bucket->second.erase(index);
+                if (bucket->second.empty())
+                {
+                    this->by_free_seats_.erase(bucket);
+                }
+            }
+            if (count < static_cast<std::size_t>(this->courses_[index].getMinParticipants()))
+            {
+                this->under_minimum_.erase(index);
+            }
+        }
+
+        // Called by a course whose participant count changed
+        void onParticipantCountChanged(std::size_t index, std::size_t old_count, std::size_t new_count)
+        {
+            this->unindexCourse(index, old_count);
+            this->indexCourse(index, new_count);
+        }
+
+        std::vector<Course> courses_; // All courses, in catalog order
+        std::set<std::size_t> available_; // Courses that are not fully booked
+        std::set<std::size_t> under_minimum_; // Courses below their minimum participant count
+        std::map<int, std::set<std::size_t>> by_free_seats_; // Free seats -> courses
+};
+
+void Course::notifyCatalog(std::size_t old_count)
+{
+    if (this->catalog_link_.catalog != nullptr)
+    {
+        this->catalog_link_.catalog->onParticipantCountChanged(this->catalog_link_.index, old_count, this->participants.size());
+    }
+}
+
+// Course with a structure-of-arrays roster. It offers the same interface as Course,
+// but instead of a vector of Student objects (vtable pointer, four strings and an
+// int each) the participants are stored column by column:
+//
+//     email_hashes_           one 64-bit email hash per participant
+//     matriculation_numbers_  one int per participant
+//     university_ids_         one interned university ID per participant
+//     name_pool_              surname, first name and email of all participants,
+//                             back to back in one string, delimited by name_offsets_
+//
+// Scans over one attribute (e.g. "all external participants", "is this email in the
+// course") only touch that attribute's contiguous array.
+class CompactCourse
+{
+    public:
+        // Constructor to initialize a course with a name, a Lecturer and its seat limits
+        CompactCourse(std::string name, Lecturer lecturer,
+                      int max_participants = Course::DEFAULT_MAX_PARTICIPANTS,
+                      int min_participants = Course::DEFAULT_MIN_PARTICIPANTS) :
+                 name_(std::move(name)), lecturer_(std::move(lecturer)), max_participants_(max_participants), min_participants_(min_participants)
+        {
+            this->email_hashes_.reserve(max_participants);
+            this->matriculation_numbers_.reserve(max_participants);
+            this->university_ids_.reserve(max_participants);
+            this->name_offsets_.reserve(3 * static_cast<std::size_t>(max_participants) + 1);
+            this->name_offsets_.push_back(0);
+            this->email_index_.reserve(max_participants);
+        }
+
+        // Maximum number of participants (seats) of this course
+        int getMaxParticipants() const { return this->max_participants_; }
+
+        // Minimum number of participants for this course to take place
+        int getMinParticipants() const { return this->min_participants_; }
+
+        // Getter for course name
+        const std::string& getName() const { return this->name_; }
+
+        // Getter for the lecturer's name
+        const std::string& getLecturerName() const { return this->lecturer_.getSurname(); }
+
+        // Getter for the Lecturer object
+        const Lecturer& getLecturer() const { return this->lecturer_; }
+
+        // Number of participants
+        std::size_t getParticipantCount() const { return this->matriculation_numbers_.size(); }
+
+        // One participant, read from the columns on access
+        class Participant
+        {
+            public:
+                Participant(const CompactCourse& course, std::size_t index) : course_(&course), index_(index)
+                {
+                }
+
+                std::string_view getSurname() const { return this->course_->surname(this->index_); }
+                std::string_view getFirstname() const { return this->course_->firstName(this->index_); }
+                std::string_view getEmail() const { return this->course_->email(this->index_); }
+                const std::string& getUniversity() const { return universityNames().name(this->getUniversityId()); }
+                std::uint32_t getUniversityId() const { return this->course_->universityId(this->index_); }
+                int getMarticulationNumber() const { return this->course_->matriculationNumber(this->index_); }
+                bool isFromHomeUniversity() const { return this->getUniversityId() == homeUniversityId(); }
+
+            private:
+                const CompactCourse* course_;
+                std::size_t index_; // Roster position
+        };
+
+        // Iterates over the participants by roster position
+        class ParticipantIterator
+        {
+            public:
+                ParticipantIterator(const CompactCourse& course, std::size_t index) : course_(&course), index_(index)
+                {
+                }
+
+                Participant operator*() const { return Participant(*this->course_, this->index_); }
+                ParticipantIterator& operator++() { ++this->index_; return *this; }
+                bool operator==(const ParticipantIterator& other) const { return this->index_ == other.index_; }
+                bool operator!=(const ParticipantIterator& other) const { return this->index_ != other.index_; }
+
+            private:
+                const CompactCourse* course_;
+                std::size_t index_; // Roster position
+        };
+
+        // The course's participants, for range-for
+        class ParticipantRange
+        {
+            public:
+                explicit ParticipantRange(const CompactCourse& course) : course_(&course)
+                {
+                }
+
+                ParticipantIterator begin() const { return ParticipantIterator(*this->course_, 0); }
+                ParticipantIterator end() const { return ParticipantIterator(*this->course_, this->size()); }
+                std::size_t size() const { return this->course_->getParticipantCount(); }
+
+            private:
+                const CompactCourse* course_;
+        };
+
+        // Participants as views into the columns; nothing is copied
+        ParticipantRange getParticipants() const { return ParticipantRange(*this); }
+
+        // Participants rebuilt as Student objects, for display code written against Course.
+        // Allocates a full copy of the roster; iterate getParticipants() instead.
+        std::vector<Student> copyParticipants() const
+        {
+            std::vector<Student> students;
+            students.reserve(this->getParticipantCount());
+            for (std::size_t i = 0; i < this->getParticipantCount(); ++i)
+            {
+                students.emplace_back(std::string(this->surname(i)), std::string(this->firstName(i)),
+                                      std::string(this->email(i)), this->matriculation_numbers_[i],
+                                      universityNames().name(this->university_ids_[i]));
+            }
+            return students;
+        }
+
+        // Column accessors for participant `i`
+        std::string_view surname(std::size_t i) const { return this->field(i, 0); }
+        std::string_view firstName(std::size_t i) const { return this->field(i, 1); }
+        std::string_view email(std::size_t i) const { return this->field(i, 2); }
+        int matriculationNumber(std::size_t i) const { return this->matriculation_numbers_[i]; }
+        std::uint32_t universityId(std::size_t i) const { return this->university_ids_[i]; }
+
+        // Contiguous column of email hashes, for roster-wide scans
+        const std::vector<std::uint64_t>& emailHashes() const { return this->email_hashes_; }
+
+        // Contiguous column of interned university IDs, for roster-wide scans
+        const std::vector<std::uint32_t>& universityIds() const { return this->university_ids_; }
+
+        // Check if the course is fully booked
+        bool isFullyBooked() const { return this->getParticipantCount() >= static_cast<std::size_t>(this->max_participants_); }
+
+        // Check if the course has fewer participants than the minimum required
+        bool hasFewParticipants() const { return this->getParticipantCount() < static_cast<std::size_t>(this->min_participants_); }
+
+        // Add a participant to the course without printing anything
+        AddResult tryAddParticipant(const Student& student)
+        {
+            if (this->isFullyBooked())
+            {
+                return AddResult::FULLY_BOOKED;
+            }
+            if (this->findParticipant(student.getEmail()) >= 0)
+            {
+                return AddResult::DUPLICATE_EMAIL;
+            }
+
+            const int position = static_cast<int>(this->getParticipantCount());
+            this->email_index_.insert(student.getEmail(), position);
+            this->email_hashes_.push_back(EmailIndex::hash(student.getEmail()));
+            this->matriculation_numbers_.push_back(student.getMarticulationNumber());
+            this->university_ids_.push_back(student.getUniversityId());
+            for (std::string_view text : { std::string_view(student.getSurname()), std::string_view(student.getFirstname()),
+                                           std::string_view(student.getEmail()) })
+            {
+                this->name_pool_ += text;
+                this->name_offsets_.push_back(static_cast<std::uint32_t>(this->name_pool_.size()));
+            }
+            return AddResult::ADDED;
+        }
+
+        // Add a participant to the course
+        bool addParticipant(const Student& student)
+        {
+            const AddResult result = this->tryAddParticipant(student);
+            if (result == AddResult::FULLY_BOOKED)
+            {
+                std::cout << "Course is already fully booked." << std::endl;
+                return false;
+            }
+            if (result == AddResult::DUPLICATE_EMAIL)
+            {
+                return false;
+            }
+            std::cout << "The Student with email: " << student.getEmail()
+                      << " was successfully added! " << std::endl;
+            return true;
+        }
+
+        // Roster position of the participant with this email, or -1 if not registered
+        int findParticipant(std::string_view email) const
+        {
+            return this->email_index_.find(email, [this](int position) { return this->email(position); });
+        }
+
+        // Render participant `i` in the same format as Student::render
+        void renderParticipant(std::size_t i, ReportWriter& out) const
+        {
+            out << "Name: " << this->firstName(i) << " " << this->surname(i)
+                << ", Email: " << this->email(i) << '\n'
+                << "University: " << universityNames().name(this->university_ids_[i])
+                << ", Matriculation Number: " << this->matriculation_numbers_[i] << '\n';
+        }
+
+        // Render all participants of the course into a report
+        void renderParticipants(ReportWriter& out) const
+        {
+            out << "Course: " << this->name_
+                << " Lecturer: " << this->lecturer_.getSurname() << '\n';
+            this->lecturer_.render(out);
+
+            if (this->hasFewParticipants())
+            {
+                out << "Course will not take place due to insufficient participants.\n";
+            }
+            else
+            {
+                out << "Participants:\n";
+                for (std::size_t i = 0; i < this->getParticipantCount(); ++i)
+                {
+                    this->renderParticipant(i, out);
+                }
+            }
+        }
+
+        // Render the available seats of the course into a report
+        void renderAvailableSeats(ReportWriter& out) const
+        {
+            out << "Course: " << this->name_ << ", Lecturer: ";
+            this->lecturer_.render(out);
+            out << "Available seats: " << (this->max_participants_ - static_cast<int>(this->getParticipantCount())) << '\n';
+        }
+
+        // Display all participants of the course
+        void displayParticipants(std::ostream& out = std::cout) const
+        {
+            ReportWriter writer;
+            this->renderParticipants(writer);
+            writer.flushTo(out);
+        }
+
+        // Display available seats in the course
+        void displayAvailableSeats(std::ostream& out = std::cout) const
+        {
+            ReportWriter writer;
+            this->renderAvailableSeats(writer);
+            writer.flushTo(out);
+        }
+
+    private:
+        // Field `k` (0 = surname, 1 = first name, 2 = email) of participant `i` in the pool
+        std::string_view field(std::size_t i, std::size_t k) const
+        {
+            const std::uint32_t begin = this->name_offsets_[3 * i + k];
+            return std::string_view(this->name_pool_).substr(begin, this->name_offsets_[3 * i + k + 1] - begin);
+        }
+
+        std::string name_; // Name of the course
+        Lecturer lecturer_; // Lecturer for the course
+        int max_participants_; // Seats of the course
+        int min_participants_; // Participants needed for the course to take place
+        std::vector<std::uint64_t> email_hashes_; // Email hash per participant
+        std::vector<int> matriculation_numbers_; // Matriculation number per participant
+        std::vector<std::uint32_t> university_ids_; // Interned university per participant
+        std::string name_pool_; // Surname, first name and email of every participant
+        std::vector<std::uint32_t> name_offsets_; // Field boundaries in name_pool_ (3 per participant, plus 0)
+        EmailIndex email_index_; // Hash index over the participants' emails
+};
+
+// Registry of every student holding at least one course, across all Course objects.
+// Students are keyed by email (and can be looked up by matriculation number); the
+// number of courses each student holds is kept next to the record, so the
+// external-student limit is checked without scanning any course roster.
+class StudentRegistry
+{
+    public:
+        // Number of courses a student from another university may take
+        static const int MAX_EXTERNAL_COURSES = 1;
+
+        // Number of registered students
+        std::size_t size() const { return this->students_.size(); }
+
+        // Make room for `count` students, e.g. before restoring a snapshot
+        void reserve(std::size_t count)
+        {
+            this->students_.reserve(count);
+            this->course_counts_.reserve(count);
+            this->email_index_.reserve(count);
+            this->by_matriculation_number_.reserve(count);
+        }
+
+        // Registered student with this email, or nullptr
+        const Student* findByEmail(const std::string& email) const
+        {
+            const int position = this->findPosition(email);
+            return position >= 0 ? &this->students_[position] : nullptr;
+        }
+
+        // Registered student with this matriculation number, or nullptr
+        const Student* findByMatriculationNumber(int matriculation_number) const
+        {
+            auto it = this->by_matriculation_number_.find(matriculation_number);
+            return it != this->by_matriculation_number_.end() ? &this->students_[it->second] : nullptr;
+        }
+
+        // Number of courses the student with this email currently holds
+        int getCourseCount(const std::string& email) const
+        {
+            const int position = this->findPosition(email);
+            return position >= 0 ? this->course_counts_[position] : 0;
+        }
+
+        // Check if the student is allowed to take one more course
+        bool mayEnroll(const Student& student) const
+        {
+            if (student.isFromHomeUniversity() || this->getCourseCount(student.getEmail()) < MAX_EXTERNAL_COURSES)
+            {
+                return true;
+            }
+            REGISTRAR_COUNT(MetricCounter::EXTERNAL_STUDENT_LIMIT);
+            return false;
+        }
+
+        // Record that the student was added to a course
+        void recordEnrollment(const Student& student)
+        {
+            int position = this->email_index_.findOrInsert(student.getEmail(), static_cast<int>(this->students_.size()),
+                                                           [this](int existing) -> const std::string&
+            {
+                return this->students_[existing].getEmail();
+            });
+            if (position < 0)
+            {
+                position = static_cast<int>(this->students_.size());
+                this->students_.push_back(student);
+                this->course_counts_.push_back(0);
+                this->by_matriculation_number_.emplace(student.getMarticulationNumber(), position);
+            }
+            ++this->course_counts_[position];
+        }
+
+        // Record that the student with this email left a course
+        void recordDrop(const std::string& email)
+        {
+            const int position = this->findPosition(email);
+            if (position >= 0 && this->course_counts_[position] > 0)
+            {
+                --this->course_counts_[position];
+            }
+        }
+
+    private:
+        // Position of the student in students_, or -1
+        int findPosition(const std::string& email) const
+        {
+            return this->email_index_.find(email, [this](int position) -> const std::string&
+            {
+                return this->students_[position].getEmail();
+            });
+        }
+
+        std::vector<Student> students_; // First registration data of every student
+        std::vector<int> course_counts_; // Courses held, parallel to students_
+        EmailIndex email_index_; // Email -> position in students_
+        std::unordered_map<int, int> by_matriculation_number_; // Matriculation number -> position in students_
+};
+
+// Drop the participant or waitlist entry with this email from `course`, keeping the
+// registry's course counts in step. A waitlisted student is only promoted if the
+// registry allows them one more course.
+DropResult dropEnrollment(Course& course, StudentRegistry& registry, const std::string& email)
+{
+    const DropResult result = course.dropParticipant(email, [&registry](const Student& student)
+    {
+        return registry.mayEnroll(student);
+    });
+    if (result.was_participant)
+    {
+        registry.recordDrop(email);
+    }
+    if (result.promoted != nullptr)
+    {
+        registry.recordEnrollment(*result.promoted);
+    }
+    return result;
+}
+
+// Thread-safe registration path for a fixed set of courses, meant to be fed by
+// several worker threads (e.g. from a request queue) without a global lock:
+//
+//  - seats are reserved with a compare-and-swap on an atomic counter per course,
+//    which never goes past the course's capacity, so a course cannot be overbooked;
+//  - duplicate emails are caught by a per-course concurrent set, striped into
+//    shards that each have their own small lock;
+//  - a reserved seat number is also the student's slot in a preallocated per-course
+//    array, so accepted students are stored without further synchronization.
+//
+// Accepted registrations are moved into the Course objects by commit(), which must
+// run after the worker threads have been joined. Student objects should be built
+// before they are handed to the workers (constructing one interns its university,
+// and the intern table is not thread-safe). The external-student limit is not
+// checked here; it needs the StudentRegistry and stays on the single-threaded path.
+class ConcurrentRegistrar
+{
+    public:
+        // Prepare concurrent state for every course, including existing participants
+        explicit ConcurrentRegistrar(CourseCatalog& courses) : courses_(courses)
+        {
+            this->states_.reserve(courses.size());
+            for (const auto& course : courses)
+            {
+                auto state = std::make_unique<CourseState>();
+                state->capacity = course.getMaxParticipants();
+                state->slots = std::make_unique<std::optional<Student>[]>(state->capacity);
+                state->committed = static_cast<int>(course.getParticipants().size());
+                state->seats_taken.store(state->committed, std::memory_order_relaxed);
+                for (const auto& participant : course.getParticipants())
+                {
+                    state->emails.insert(participant.getEmail());
+                }
+                this->states_.push_back(std::move(state));
+            }
+        }
+
+        // Register a student for the course at `course_index`; safe to call from any thread
+        AddResult registerStudent(std::size_t course_index, const Student& student)
+        {
+            CourseState& state = *this->states_[course_index];
+
+            // Cheap early exit, rechecked by the compare-and-swap below
+            if (state.seats_taken.load(std::memory_order_relaxed) >= state.capacity)
+            {
+                return AddResult::FULLY_BOOKED;
+            }
+            if (!state.emails.insert(student.getEmail()))
+            {
+                return AddResult::DUPLICATE_EMAIL;
+            }
+
+            int seat = state.seats_taken.load(std::memory_order_relaxed);
+            do
+            {
+                if (seat >= state.capacity)
+                {
+                    // Lost the race for the last seat: give the email back
+                    state.emails.erase(student.getEmail());
+                    return AddResult::FULLY_BOOKED;
+                }
+            } while (!state.seats_taken.compare_exchange_weak(seat, seat + 1, std::memory_order_acq_rel));
+
+            state.slots[seat].emplace(student);
+            return AddResult::ADDED;
+        }
+
+        // Seats currently taken in the course at `course_index`
+        int getSeatsTaken(std::size_t course_index) const
+        {
+            return this->states_[course_index]->seats_taken.load(std::memory_order_acquire);
+        }
+
+        // Move all accepted registrations into the courses (no worker may be running)
+        void commit()
+        {
+            for (std::size_t i = 0; i < this->states_.size(); ++i)
+            {
+                CourseState& state = *this->states_[i];
+                const int taken = state.seats_taken.load(std::memory_order_acquire);
+                for (; state.committed < taken; ++state.committed)
+                {
+                    this->courses_[i].tryAddParticipant(std::move(*state.slots[state.committed]));
+                    state.slots[state.committed].reset();
+                }
+            }
+        }
+
+    private:
+        // Set of emails striped into independently locked shards
+        class ConcurrentEmailSet
+        {
+            public:
+                // Insert `email`; false if it (case-insensitively) is already in the set
+                bool insert(const std::string& email)
+                {
+                    Shard& shard = this->shardFor(email);
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    if (shard.find(email) >= 0)
+                    {
+                        return false;
+                    }
+                    shard.index.insert(email, static_cast<int>(shard.emails.size()));
+                    shard.emails.push_back(email);
+                    return true;
+                }
+
+                // Remove `email` again (its slot is blanked, so it no longer matches)
+                void erase(const std::string& email)
+                {
+                    Shard& shard = this->shardFor(email);
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    const int position = shard.find(email);
+                    if (position >= 0)
+                    {
+                        shard.emails[position].clear();
+                    }
+                }
+
+            private:
+                struct Shard
+                {
+                    std::mutex mutex;
+                    EmailIndex index; // Email -> position in emails
+                    std::vector<std::string> emails;
+
+                    int find(const std::string& email) const
+                    {
+                        return this->index.find(email, [this](int position) -> const std::string& { return this->emails[position]; });
+                    }
+                };
+
+                static const std::size_t SHARD_COUNT = 16;
+
+                Shard& shardFor(const std::string& email)
+                {
+                    // Use high bits of the hash, EmailIndex probes with the low bits
+                    return this->shards_[(EmailIndex::hash(email) >> 56) % SHARD_COUNT];
+                }
+
+                Shard shards_[SHARD_COUNT];
+        };
+
+        // Concurrent registration state of one course
+        struct CourseState
+        {
+            std::atomic<int> seats_taken{0}; // Seats handed out, never above capacity
+            int capacity = 0; // Seats of the course
+            int committed = 0; // Seats already moved into the Course
+            std::unique_ptr<std::optional<Student>[]> slots; // Student per seat number
+            ConcurrentEmailSet emails; // Emails holding (or trying to get) a seat
+        };
+
+        CourseCatalog& courses_; // Courses registrations are committed to
+        std::vector<std::unique_ptr<CourseState>> states_; // Per-course state, parallel to courses_
+};
+
+// Stress test for ConcurrentRegistrar: `thread_count` workers register overlapping
+// students (every email is tried twice) into a small set of courses. Verifies that
+// no course is overbooked, no email appears twice in a course and every accepted
+// registration ends up in its course. Returns true if all checks pass.
+bool stressConcurrentRegistrar(std::size_t thread_count)
+{
+    Lecturer lecturer("Ada", "Lovelace", "ada.lovelace@uni.org", PROF);
+    std::vector<Course> courses;
+    const std::size_t course_count = 1000;
+    courses.reserve(course_count);
+    for (std::size_t i = 0; i < course_count; ++i)
+    {
+        courses.emplace_back("Course " + std::to_string(i), lecturer);
+    }
+    CourseCatalog catalog(std::move(courses));
+
+    // Twice as many distinct students as seats, each submitted twice (as upper and lower case)
+    std::vector<Student> students;
+    const std::size_t distinct = course_count * Course::DEFAULT_MAX_PARTICIPANTS * 2;
+    students.reserve(distinct * 2);
+    for (std::size_t i = 0; i < distinct; ++i)
+    {
+        students.emplace_back("Surname", "First", "student" + std::to_string(i) + "@uni.org", static_cast<int>(i), HOME_UNIVERSITY);
+        students.emplace_back("Surname", "First", "STUDENT" + std::to_string(i) + "@UNI.ORG", static_cast<int>(i), HOME_UNIVERSITY);
+    }
+
+    ConcurrentRegistrar registrar(catalog);
+    std::atomic<std::size_t> added{0};
+    std::vector<std::thread> workers;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < thread_count; ++t)
+    {
+        workers.emplace_back([&, t]()
+        {
+            std::size_t local_added = 0;
+            std::mt19937 random(static_cast<unsigned>(t));
+            const std::size_t offset = random() % students.size();
+            for (std::size_t i = 0; i < students.size(); ++i)
+            {
+                const std::size_t s = (offset + i * (t + 1)) % students.size();
+                const std::size_t course = (s / 2) % course_count; // Both spellings go to the same course
+                local_added += registrar.registerStudent(course, students[s]) == AddResult::ADDED;
+            }
+            added += local_added;
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    registrar.commit();
+
+    bool ok = true;
+    std::size_t committed = 0;
+    for (const auto& course : catalog)
+    {
+        const auto& participants = course.getParticipants();
+        committed += participants.size();
+        ok = ok && participants.size() <= static_cast<std::size_t>(course.getMaxParticipants());
+        for (std::size_t i = 0; i < participants.size(); ++i)
+        {
+            ok = ok && course.findParticipant(participants[i].getEmail()) == static_cast<int>(i);
+        }
+    }
+    ok = ok && committed == added && committed == course_count * Course::DEFAULT_MAX_PARTICIPANTS;
+    ok = ok && catalog.coursesWithAvailableSeats().empty() && catalog.coursesUnderMinimum().empty();
+
+    std::cout << "Concurrent registration with " << thread_count << " threads: "
+              << thread_count * students.size() / elapsed.count() << " requests/s, "
+              << committed << " seats filled - " << (ok ? "PASS" : "FAIL") << "\n";
+    return ok;
+}
+
+// End-of-term notification pass for the courses that will not take place. Every
+// student of a cancelled course gets one notification listing all of their cancelled
+// courses, and notifications come out in the order a serial walk over the catalog
+// first reaches each student (course order, then roster order). The work is split
+// across threads in four phases, each ending in a join:
+//
+//  1. collect  each thread takes a contiguous range of cancelled courses and records
+//              one Notice per (student, course), bucketed by email hash
+//  2. dedupe   each thread sorts one bucket (from all threads) and groups the notices
+//              of the same student; emails compare case-insensitively, as in EmailIndex
+//  3. order    a student's first notice has a unique sequence number in the serial
+//              walk, so each student is dropped straight into its slot of one array
+//  4. render   the ordered students are split into ranges rendered in parallel, and
+//              the buffers are appended to the output in order
+//
+// The catalog must not change while render() runs.
+class CancellationNotifier
+{
+    public:
+        explicit CancellationNotifier(const CourseCatalog& courses, std::size_t thread_count = defaultThreadCount()) :
+                                      courses_(courses), thread_count_(std::max<std::size_t>(1, thread_count))
+        {
+        }
+
+        // One thread per hardware thread
+        static std::size_t defaultThreadCount()
+        {
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+
+        // Render the notifications into `out`; returns the number of students notified
+        std::size_t render(ReportWriter& out)
+        {
+            const std::size_t threads = this->thread_count_;
+            this->cancelled_.assign(this->courses_.coursesUnderMinimum().begin(), this->courses_.coursesUnderMinimum().end());
+            this->sequence_start_.assign(1, 0);
+            this->course_names_.clear();
+            for (std::size_t index : this->cancelled_)
+            {
+                this->sequence_start_.push_back(this->sequence_start_.back() + this->courses_[index].getParticipants().size());
+                this->course_names_.push_back(this->courses_[index].getName());
+            }
+
+            // 1. collect: notices[thread][bucket]
+            std::vector<std::vector<std::vector<Notice>>> notices(threads, std::vector<std::vector<Notice>>(threads));
+            parallel(threads, [&](std::size_t t)
+            {
+                const std::size_t first = this->cancelled_.size() * t / threads;
+                const std::size_t last = this->cancelled_.size() * (t + 1) / threads;
+                for (std::size_t rank = first; rank < last; ++rank)
+                {
+                    const auto& participants = this->courses_[this->cancelled_[rank]].getParticipants();
+                    for (std::size_t position = 0; position < participants.size(); ++position)
+                    {
+                        const std::string& email = participants[position].getEmail();
+                        const std::uint64_t h = EmailIndex::hash(email);
+                        notices[t][h % threads].push_back(Notice{h, email, static_cast<std::uint32_t>(rank), static_cast<std::uint32_t>(position)});
+                    }
+                }
+            });
+
+            // 2. dedupe: one bucket per thread, grouped into recipients
+            std::vector<std::vector<Notice>> buckets(threads);
+            std::vector<std::vector<Recipient>> recipients(threads);
+            parallel(threads, [&](std::size_t b)
+            {
+                std::vector<Notice>& bucket = buckets[b];
+                for (std::size_t t = 0; t < threads; ++t)
+                {
+                    bucket.insert(bucket.end(), notices[t][b].begin(), notices[t][b].end());
+                }
+                std::sort(bucket.begin(), bucket.end(), [](const Notice& x, const Notice& y)
+                {
+                    return std::tie(x.hash, x.course_rank, x.position) < std::tie(y.hash, y.course_rank, y.position);
+                });
+                for (auto run = bucket.begin(); run != bucket.end();)
+                {
+                    const std::uint64_t h = run->hash;
+                    const auto run_end = std::find_if(run, bucket.end(), [h](const Notice& n) { return n.hash != h; });
+                    // Different emails with the same hash are split apart, keeping each one's notices in order
+                    while (run != run_end)
+                    {
+                        const std::string_view email = run->email;
+                        auto same = [email](const Notice& n) { return n.email == email || EmailIndex::sameEmail(n.email, email); };
+                        auto group_end = std::find_if_not(run + 1, run_end, same);
+                        if (group_end != run_end)
+                        {
+                            group_end = std::stable_partition(group_end, run_end, same);
+                        }
+                        recipients[b].push_back(Recipient{&*run, &*run + (group_end - run)});
+                        run = group_end;
+                    }
+                }
+            });
+
+            // 3. order: by the sequence number of each student's first notice
+            std::vector<const Recipient*> slots(this->sequence_start_.back(), nullptr);
+            parallel(threads, [&](std::size_t b)
+            {
+                for (const Recipient& recipient : recipients[b])
+                {
+                    slots[this->sequenceOf(*recipient.first)] = &recipient;
+                }
+            });
+            slots.erase(std::remove(slots.begin(), slots.end(), nullptr), slots.end());
+
+            // 4. render
+            std::vector<ReportWriter> parts(threads);
+            parallel(threads, [&](std::size_t t)
+            {
+                const std::size_t first = slots.size() * t / threads;
+                const std::size_t last = slots.size() * (t + 1) / threads;
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    this->renderRecipient(*slots[i], parts[t]);
+                }
+            });
+            for (const ReportWriter& part : parts)
+            {
+                out << part.view();
+            }
+            return slots.size();
+        }
+
+    private:
+        // A student's place in a cancelled course
+        struct Notice
+        {
+            std::uint64_t hash; // Email hash
+            std::string_view email; // The student's email, compared without going through the course
+            std::uint32_t course_rank; // Position in cancelled_
+            std::uint32_t position; // Roster position in that course
+        };
+
+        // All notices of one student, a range of a sorted bucket, first course first
+        struct Recipient
+        {
+            const Notice* first;
+            const Notice* last;
+        };
+
+        // Run work(0) .. work(tasks - 1), each on its own thread
+        template <typename Work>
+        static void parallel(std::size_t tasks, Work&& work)
+        {
+            std::vector<std::thread> workers;
+            workers.reserve(tasks - 1);
+            for (std::size_t t = 1; t < tasks; ++t)
+            {
+                workers.emplace_back([&work, t]() { work(t); });
+            }
+            work(0);
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        const Student& student(const Notice& notice) const
+        {
+            return this->courses_[this->cancelled_[notice.course_rank]].getParticipants()[notice.position];
+        }
+
+        // Position of the notice in the serial walk over all cancelled courses
+        std::size_t sequenceOf(const Notice& notice) const
+        {
+            return this->sequence_start_[notice.course_rank] + notice.position;
+        }
+
+        void renderRecipient(const Recipient& recipient, ReportWriter& out) const
+        {
+            this->student(*recipient.first).render(out);
+            out << "Cancelled courses: ";
+            for (const Notice* notice = recipient.first; notice != recipient.last; ++notice)
+            {
+                out << (notice == recipient.first ? "" : ", ") << this->course_names_[notice->course_rank];
+            }
+            out << '\n';
+        }
+
+        const CourseCatalog& courses_; // Courses to notify about
+        std::size_t thread_count_; // Threads per phase
+        std::vector<std::size_t> cancelled_; // Catalog indices of the cancelled courses, in catalog order
+        std::vector<std::size_t> sequence_start_; // Serial-walk position of each cancelled course's first participant
+        std::vector<std::string_view> course_names_; // Names of the cancelled courses
+};
+
+// Reasons an imported enrollment row can be rejected
+enum class ImportReject
+{
+    MALFORMED_ROW,
+    UNKNOWN_COURSE,
+    FULLY_BOOKED,
+    DUPLICATE_EMAIL,
+    EXTERNAL_STUDENT_LIMIT
+};
+
+// Human readable name of a reject reason
+const char* importRejectName(ImportReject reason)
+{
+    switch (reason)
+    {
+        case ImportReject::MALFORMED_ROW: return "malformed row";
+        case ImportReject::UNKNOWN_COURSE: return "unknown course";
+        case ImportReject::FULLY_BOOKED: return "course fully booked";
+        case ImportReject::DUPLICATE_EMAIL: return "duplicate email";
+        case ImportReject::EXTERNAL_STUDENT_LIMIT: return "external student limit";
+    }
+    return "unknown";
+}
+
+// Result of a bulk enrollment import
+struct ImportReport
+{
+    // A rejected row: its line number in the file and why it was rejected
+    struct Reject
+    {
+        std::size_t line;
+        ImportReject reason;
+    };
+
+    std::size_t rows = 0;        // Data rows read (comments and blank lines excluded)
+    std::size_t added = 0;       // Rows that resulted in a registration
+    std::vector<Reject> rejects; // Every rejected row, in file order
+    bool file_opened = false;    // False if the file could not be read at all
+
+    // Print a summary followed by one line per rejected row
+    void print(std::ostream& out) const
+    {
+        out << "Imported " << this->added << " of " << this->rows << " enrollment rows, "
+            << this->rejects.size() << " rejected.\n";
+        for (const auto& reject : this->rejects)
+        {
+            out << "  line " << reject.line << ": " << importRejectName(reject.reason) << "\n";
+        }
+    }
+};
+
+// Streaming importer for enrollment files with one registration per line:
+//
+//     email,first_name,surname,university,matriculation_number,course_name
+//
+// The file is read in large chunks; each chunk is split into rows whose fields are
+// string_views into the chunk buffer, and the rows of a chunk are then applied as
+// one batch. Blank lines, lines starting with '#' and a header row starting with
+// "email" are skipped.
+class EnrollmentImporter
+{
+    public:
+        // Size of the read buffer (a line must fit into it)
+        static const std::size_t CHUNK_SIZE = 1 << 20;
+
+        EnrollmentImporter(CourseCatalog& courses, StudentRegistry& registry) :
+                 courses_(courses), registry_(registry)
+        {
+            for (auto& course : courses)
+            {
+                this->course_by_name_.emplace(course.getName(), &course);
+            }
+        }
+
+        // Import all rows of the file at `path`
+        ImportReport importFile(const std::string& path)
+        {
+            ImportReport report;
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+            {
+                return report;
+            }
+            report.file_opened = true;
+
+            std::vector<char> buffer(CHUNK_SIZE);
+            std::size_t carried = 0; // Bytes of an incomplete last line kept from the previous chunk
+            std::size_t line = 0;
+            while (in)
+            {
+                in.read(buffer.data() + carried, static_cast<std::streamsize>(buffer.size() - carried));
+                const std::size_t filled = carried + static_cast<std::size_t>(in.gcount());
+                if (filled == 0)
+                {
+                    break;
+                }
+
+                // Without more input the last line is complete even without a newline
+                std::string_view chunk(buffer.data(), filled);
+                std::size_t end = in ? chunk.rfind('\n') + 1 : filled;
+                if (end == 0)
+                {
+                    // A single line longer than the buffer cannot be parsed
+                    report.rejects.push_back({line + 1, ImportReject::MALFORMED_ROW});
+                    break;
+                }
+
+                this->parseChunk(chunk.substr(0, end), line, report);
+                this->applyBatch(report);
+
+                carried = filled - end;
+                std::copy(buffer.begin() + end, buffer.begin() + filled, buffer.begin());
+            }
+
+            // Malformed rows are found while parsing, the others while applying a batch
+            std::stable_sort(report.rejects.begin(), report.rejects.end(),
+                             [](const ImportReport::Reject& a, const ImportReport::Reject& b) { return a.line < b.line; });
+            return report;
+        }
+
+    private:
+        // Fields of one row, pointing into the chunk buffer
+        struct Row
+        {
+            std::size_t line;
+            std::string_view email, first_name, surname, university, course;
+            int matriculation_number;
+        };
+
+        // Split a chunk of complete lines into rows
+        void parseChunk(std::string_view chunk, std::size_t& line, ImportReport& report)
+        {
+            this->batch_.clear();
+            while (!chunk.empty())
+            {
+                std::size_t newline = chunk.find('\n');
+                std::string_view text = chunk.substr(0, newline);
+                chunk.remove_prefix(newline == std::string_view::npos ? chunk.size() : newline + 1);
+                ++line;
+
+                if (!text.empty() && text.back() == '\r')
+                {
+                    text.remove_suffix(1);
+                }
+                if (text.empty() || text.front() == '#' || (line == 1 && text.substr(0, 5) == "email"))
+                {
+                    continue;
+                }
+
+                ++report.rows;
+                std::string_view fields[6];
+                std::size_t count = 0;
+                while (count < 6)
+                {
+                    std::size_t comma = text.find(',');
+                    fields[count++] = text.substr(0, comma);
+                    if (comma == std::string_view::npos)
+                    {
+                        text = std::string_view();
+                        break;
+                    }
+                    text.remove_prefix(comma + 1);
+                }
+
+                Row row{line, fields[0], fields[1], fields[2], fields[3], fields[5], 0};
+                const char* number_end = fields[4].data() + fields[4].size();
+                if (count != 6 || !text.empty() || fields[0].empty() || fields[5].empty()
+                    || std::from_chars(fields[4].data(), number_end, row.matriculation_number).ptr != number_end)
+                {
+                    report.rejects.push_back({line, ImportReject::MALFORMED_ROW});
+                    continue;
+                }
+                this->batch_.push_back(row);
+            }
+        }
+
+        // Register the parsed rows of the current chunk
+        void applyBatch(ImportReport& report)
+        {
+            for (const Row& row : this->batch_)
+            {
+                auto course = this->course_by_name_.find(row.course);
+                if (course == this->course_by_name_.end())
+                {
+                    report.rejects.push_back({row.line, ImportReject::UNKNOWN_COURSE});
+                    continue;
+                }
+
+                Student student(std::string(row.surname), std::string(row.first_name), std::string(row.email),
+                                row.matriculation_number, row.university);
+                if (!this->registry_.mayEnroll(student))
+                {
+                    report.rejects.push_back({row.line, ImportReject::EXTERNAL_STUDENT_LIMIT});
+                    continue;
+                }
+
+                switch (course->second->tryAddParticipant(std::move(student)))
+                {
+                    case AddResult::ADDED:
+                        this->registry_.recordEnrollment(course->second->getParticipants().back());
+                        ++report.added;
+                        break;
+                    case AddResult::FULLY_BOOKED:
+                    case AddResult::WAITLISTED: // Not returned by tryAddParticipant
+                        report.rejects.push_back({row.line, ImportReject::FULLY_BOOKED});
+                        break;
+                    case AddResult::DUPLICATE_EMAIL:
+                        report.rejects.push_back({row.line, ImportReject::DUPLICATE_EMAIL});
+                        break;
+                }
+            }
+        }
+
+        CourseCatalog& courses_; // Courses rows are registered into
+        StudentRegistry& registry_; // Registry enforcing the external-student limit
+        std::unordered_map<std::string_view, Course*> course_by_name_; // Course name -> course
+        std::vector<Row> batch_; // Rows of the current chunk, reused between chunks
+};
+
+// Read-only view of a whole file: memory-mapped where the platform supports it,
+// otherwise read into memory once
+class MappedFile
+{
+    public:
+        explicit MappedFile(const std::string& path)
+        {
+#ifdef _WIN32
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+            {
+                return;
+            }
+            this->contents_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            this->data_ = this->contents_.data();
+            this->size_ = this->contents_.size();
+            this->open_ = true;
+#else
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                return;
+            }
+            struct stat info;
+            if (::fstat(fd, &info) == 0)
+            {
+                this->size_ = static_cast<std::size_t>(info.st_size);
+                this->open_ = true;
+                if (this->size_ > 0)
+                {
+                    void* mapping = ::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (mapping == MAP_FAILED)
+                    {
+                        this->open_ = false;
+                        this->size_ = 0;
+                    }
+                    else
+                    {
+                        this->data_ = static_cast<const char*>(mapping);
+                    }
+                }
+            }
+            ::close(fd);
+#endif
+        }
+
+        ~MappedFile()
+        {
+#ifndef _WIN32
+            if (this->data_ != nullptr)
+            {
+                ::munmap(const_cast<char*>(this->data_), this->size_);
+            }
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // False if the file does not exist or could not be mapped
+        bool isOpen() const { return this->open_; }
+
+        // The file's bytes
+        std::string_view view() const { return std::string_view(this->data_, this->size_); }
+
+    private:
+        const char* data_ = nullptr; // First byte of the file
+        std::size_t size_ = 0; // File size in bytes
+        bool open_ = false; // File was found and mapped
+#ifdef _WIN32
+        std::vector<char> contents_; // File contents when mapping is not available
+#endif
+};
+
+// Appends fixed-width fields to a byte buffer for the binary on-disk formats.
+// Numbers are written in host byte order; strings as a 16-bit length plus the bytes.
+class BinaryWriter
+{
+    public:
+        void u8(std::uint8_t value) { this->put(value); }
+        void u16(std::uint16_t value) { this->put(value); }
+        void u32(std::uint32_t value) { this->put(value); }
+        void i32(std::int32_t value) { this->put(value); }
+
+        // Strings longer than 65535 bytes are cut off
+        void text(std::string_view value)
+        {
+            const std::size_t length = std::min<std::size_t>(value.size(), 0xFFFF);
+            this->u16(static_cast<std::uint16_t>(length));
+            this->buffer_.append(value.data(), length);
+        }
+
+        // Overwrite a 32-bit field written earlier at `offset`
+        void patchU32(std::size_t offset, std::uint32_t value)
+        {
+            std::memcpy(&this->buffer_[offset], &value, sizeof(value));
+        }
+
+        std::size_t size() const { return this->buffer_.size(); }
+        std::string_view view() const { return this->buffer_; }
+        void clear() { this->buffer_.clear(); }
+
+    private:
+        template <typename T>
+        void put(T value)
+        {
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            this->buffer_.append(bytes, sizeof(T));
+        }
+
+        std::string buffer_; // Encoded bytes
+};
+
+// Reads the fields written by BinaryWriter, failing (returning false) instead of
+// reading past the end of the data
+class BinaryReader
+{
+    public:
+        explicit BinaryReader(std::string_view data) : data_(data)
+        {
+        }
+
+        bool u8(std::uint8_t& value) { return this->get(value); }
+        bool u16(std::uint16_t& value) { return this->get(value); }
+        bool u32(std::uint32_t& value) { return this->get(value); }
+        bool i32(std::int32_t& value) { return this->get(value); }
+
+        // A string, as a view into the underlying data
+        bool text(std::string_view& value)
+        {
+            std::uint16_t length = 0;
+            if (!this->u16(length) || this->data_.size() - this->offset_ < length)
+            {
+                return false;
+            }
+            value = this->data_.substr(this->offset_, length);
+            this->offset_ += length;
+            return true;
+        }
+
+        // The next `length` bytes
+        bool bytes(std::size_t length, std::string_view& value)
+        {
+            if (this->data_.size() - this->offset_ < length)
+            {
+                return false;
+            }
+            value = this->data_.substr(this->offset_, length);
+            this->offset_ += length;
+            return true;
+        }
+
+        std::size_t offset() const { return this->offset_; }
+        bool atEnd() const { return this->offset_ == this->data_.size(); }
+
+    private:
+        template <typename T>
+        bool get(T& value)
+        {
+            if (this->data_.size() - this->offset_ < sizeof(T))
+            {
+                return false;
+            }
+            std::memcpy(&value, this->data_.data() + this->offset_, sizeof(T));
+            this->offset_ += sizeof(T);
+            return true;
+        }
+
+        std::string_view data_; // Bytes being read
+        std::size_t offset_ = 0; // Read position
+};
+
+// Flat binary roster snapshot (version 4). Every field is a 32-bit number in host byte
+// order and every record is 4-byte aligned, so a mapped snapshot is queried in place:
+//
+//     header        SnapshotHeader
+//     courses       course_count x SnapshotCourse
+//     participants  participant_count x SnapshotParticipant, grouped by course: each
+//                   course's participants followed by its waitlist, in waitlist order
+//     strings       string pool; SnapshotString offsets are relative to its start
+//
+// Course and lecturer details are included so readers need no other source.
+// Strings shared by many records (university names) are stored once.
+struct SnapshotString
+{
+    std::uint32_t offset; // Start in the string pool
+    std::uint32_t length; // Length in bytes
+};
+
+struct SnapshotHeader
+{
+    std::uint32_t magic; // SNAPSHOT_MAGIC
+    std::uint32_t version; // SNAPSHOT_VERSION
+    std::uint32_t course_count; // Number of SnapshotCourse records
+    std::uint32_t participant_count; // Number of SnapshotParticipant records (participants and waitlists)
+    std::uint32_t courses_offset; // File offset of the course table
+    std::uint32_t participants_offset; // File offset of the participant table
+    std::uint32_t strings_offset; // File offset of the string pool
+    std::uint32_t strings_size; // Size of the string pool in bytes
+    std::uint32_t log_generation; // Log records of an earlier generation are already included
+};
+
+struct SnapshotCourse
+{
+    SnapshotString name;
+    SnapshotString lecturer_surname;
+    SnapshotString lecturer_first_name;
+    SnapshotString lecturer_email;
+    std::uint32_t lecturer_title; // Title value
+    std::int32_t max_participants;
+    std::int32_t min_participants;
+    std::uint32_t first_participant; // Index of the course's first participant record
+    std::uint32_t participant_count;
+    std::uint32_t waitlist_count; // Waitlist records following the participants
+};
+
+struct SnapshotParticipant
+{
+    SnapshotString surname;
+    SnapshotString first_name;
+    SnapshotString email;
+    SnapshotString university;
+    std::int32_t matriculation_number;
+};
+
+static_assert(sizeof(SnapshotHeader) == 36 && sizeof(SnapshotCourse) == 56 && sizeof(SnapshotParticipant) == 36,
+              "snapshot records must have no padding");
+
+const std::uint32_t SNAPSHOT_MAGIC = 0x4E535243; // "CRSN"
+const std::uint32_t SNAPSHOT_VERSION = 4;
+
+// Encode the rosters and waitlists of all courses as a snapshot that takes over from
+// log records of generations before `log_generation` (see EnrollmentStore)
+std::string encodeRosterSnapshot(const CourseCatalog& courses, std::uint32_t log_generation = 0)
+{
+    std::size_t participant_count = 0;
+    for (const auto& course : courses)
+    {
+        participant_count += course.getParticipants().size() + course.getWaitlistSize();
+    }
+
+    SnapshotHeader header{};
+    header.magic = SNAPSHOT_MAGIC;
+    header.version = SNAPSHOT_VERSION;
+    header.log_generation = log_generation;
+    header.course_count = static_cast<std::uint32_t>(courses.size());
+    header.participant_count = static_cast<std::uint32_t>(participant_count);
+    header.courses_offset = sizeof(SnapshotHeader);
+    header.participants_offset = header.courses_offset + header.course_count * sizeof(SnapshotCourse);
+    header.strings_offset = header.participants_offset + header.participant_count * sizeof(SnapshotParticipant);
+
+    std::string bytes(header.strings_offset, '\0');
+    std::string pool;
+    auto addString = [&pool](std::string_view text)
+    {
+        const SnapshotString ref{static_cast<std::uint32_t>(pool.size()), static_cast<std::uint32_t>(text.size())};
+        pool.append(text.data(), text.size());
+        return ref;
+    };
+    std::vector<SnapshotString> universities(universityNames().size(), SnapshotString{0, 0});
+    std::vector<bool> university_stored(universities.size(), false);
+
+    std::uint32_t next_participant = 0;
+    for (std::uint32_t c = 0; c < header.course_count; ++c)
+    {
+        const Course& course = courses[c];
+        const Lecturer& lecturer = course.getLecturer();
+        SnapshotCourse record{};
+        record.name = addString(course.getName());
+        record.lecturer_surname = addString(lecturer.getSurname());
+        record.lecturer_first_name = addString(lecturer.getFirstname());
+        record.lecturer_email = addString(lecturer.getEmail());
+        record.lecturer_title = static_cast<std::uint32_t>(lecturer.get_academic_title());
+        record.max_participants = course.getMaxParticipants();
+        record.min_participants = course.getMinParticipants();
+        record.first_participant = next_participant;
+        record.participant_count = static_cast<std::uint32_t>(course.getParticipants().size());
+        record.waitlist_count = static_cast<std::uint32_t>(course.getWaitlistSize());
+        std::memcpy(&bytes[header.courses_offset + c * sizeof(SnapshotCourse)], &record, sizeof(record));
+
+        auto addParticipant = [&](const Student& student)
+        {
+            const std::uint32_t university = student.getUniversityId();
+            if (!university_stored[university])
+            {
+                universities[university] = addString(student.getUniversity());
+                university_stored[university] = true;
+            }
+            SnapshotParticipant participant{};
+            participant.surname = addString(student.getSurname());
+            participant.first_name = addString(student.getFirstname());
+            participant.email = addString(student.getEmail());
+            participant.university = universities[university];
+            participant.matriculation_number = student.getMarticulationNumber();
+            std::memcpy(&bytes[header.participants_offset + next_participant * sizeof(SnapshotParticipant)],
+                        &participant, sizeof(participant));
+            ++next_participant;
+        };
+        for (const auto& student : course.getParticipants())
+        {
+            addParticipant(student);
+        }
+        course.forEachWaitlisted(addParticipant);
+    }
+
+    header.strings_size = static_cast<std::uint32_t>(pool.size());
+    std::memcpy(&bytes[0], &header, sizeof(header));
+    bytes += pool;
+    return bytes;
+}
+
+// Read-only access to a snapshot held in memory (usually a MappedFile),
+// with the query surface of Course. Nothing is copied or decoded up front: records
+// are read from the bytes on access and strings are views into the string pool.
+// The bytes must outlive the view and everything obtained from it.
+class RosterSnapshotView
+{
+    public:
+        // One participant record
+        class Participant
+        {
+            public:
+                Participant(const RosterSnapshotView& snapshot, const SnapshotParticipant& record) :
+                            snapshot_(&snapshot), record_(record)
+                {
+                }
+
+                std::string_view getSurname() const { return this->snapshot_->text(this->record_.surname); }
+                std::string_view getFirstname() const { return this->snapshot_->text(this->record_.first_name); }
+                std::string_view getEmail() const { return this->snapshot_->text(this->record_.email); }
+                std::string_view getUniversity() const { return this->snapshot_->text(this->record_.university); }
+                int getMarticulationNumber() const { return this->record_.matriculation_number; }
+                bool isFromHomeUniversity() const { return this->getUniversity() == HOME_UNIVERSITY; }
+
+            private:
+                const RosterSnapshotView* snapshot_;
+                SnapshotParticipant record_;
+        };
+
+        // Iterates over a course's participant records
+        class ParticipantIterator
+        {
+            public:
+                ParticipantIterator(const RosterSnapshotView& snapshot, std::uint32_t index) :
+                                    snapshot_(&snapshot), index_(index)
+                {
+                }
+
+                Participant operator*() const { return Participant(*this->snapshot_, this->snapshot_->participantRecord(this->index_)); }
+                ParticipantIterator& operator++() { ++this->index_; return *this; }
+                bool operator==(const ParticipantIterator& other) const { return this->index_ == other.index_; }
+                bool operator!=(const ParticipantIterator& other) const { return this->index_ != other.index_; }
+
+            private:
+                const RosterSnapshotView* snapshot_;
+                std::uint32_t index_; // Participant record index
+        };
+
+        // A course's participants, for range-for
+        class ParticipantRange
+        {
+            public:
+                ParticipantRange(const RosterSnapshotView& snapshot, std::uint32_t first, std::uint32_t count) :
+                                 snapshot_(&snapshot), first_(first), count_(count)
+                {
+                }
+
+                ParticipantIterator begin() const { return ParticipantIterator(*this->snapshot_, this->first_); }
+                ParticipantIterator end() const { return ParticipantIterator(*this->snapshot_, this->first_ + this->count_); }
+                std::size_t size() const { return this->count_; }
+
+            private:
+                const RosterSnapshotView* snapshot_;
+                std::uint32_t first_; // First participant record index
+                std::uint32_t count_; // Number of participants
+        };
+
+        // One course record
+        class CourseView
+        {
+            public:
+                CourseView(const RosterSnapshotView& snapshot, const SnapshotCourse& record) :
+                           snapshot_(&snapshot), record_(record)
+                {
+                }
+
+                std::string_view getName() const { return this->snapshot_->text(this->record_.name); }
+                std::string_view getLecturerName() const { return this->snapshot_->text(this->record_.lecturer_surname); }
+                std::string_view getLecturerFirstname() const { return this->snapshot_->text(this->record_.lecturer_first_name); }
+                std::string_view getLecturerEmail() const { return this->snapshot_->text(this->record_.lecturer_email); }
+                Title getLecturerTitle() const { return static_cast<Title>(this->record_.lecturer_title); }
+                int getMaxParticipants() const { return this->record_.max_participants; }
+                int getMinParticipants() const { return this->record_.min_participants; }
+                std::size_t getParticipantCount() const { return this->record_.participant_count; }
+
+                bool isFullyBooked() const
+                {
+                    return this->record_.participant_count >= static_cast<std::uint32_t>(std::max(this->record_.max_participants, 0));
+                }
+
+                bool hasFewParticipants() const
+                {
+                    return this->record_.participant_count < static_cast<std::uint32_t>(std::max(this->record_.min_participants, 0));
+                }
+
+                ParticipantRange getParticipants() const
+                {
+                    return ParticipantRange(*this->snapshot_, this->record_.first_participant, this->record_.participant_count);
+                }
+
+                std::size_t getWaitlistSize() const { return this->record_.waitlist_count; }
+
+                // Waiting students, first in line first
+                ParticipantRange getWaitlist() const
+                {
+                    return ParticipantRange(*this->snapshot_, this->record_.first_participant + this->record_.participant_count,
+                                            this->record_.waitlist_count);
+                }
+
+            private:
+                const RosterSnapshotView* snapshot_;
+                SnapshotCourse record_;
+        };
+
+        // Check the header and table bounds of `bytes`; see valid()
+        explicit RosterSnapshotView(std::string_view bytes) : bytes_(bytes)
+        {
+            if (bytes.size() < sizeof(SnapshotHeader))
+            {
+                return;
+            }
+            std::memcpy(&this->header_, bytes.data(), sizeof(SnapshotHeader));
+            const SnapshotHeader& h = this->header_;
+            const std::uint64_t courses_end = std::uint64_t(h.courses_offset) + std::uint64_t(h.course_count) * sizeof(SnapshotCourse);
+            const std::uint64_t participants_end = std::uint64_t(h.participants_offset)
+                                                 + std::uint64_t(h.participant_count) * sizeof(SnapshotParticipant);
+            const std::uint64_t strings_end = std::uint64_t(h.strings_offset) + h.strings_size;
+            this->valid_ = h.magic == SNAPSHOT_MAGIC && h.version == SNAPSHOT_VERSION
+                        && courses_end <= bytes.size() && participants_end <= bytes.size() && strings_end <= bytes.size();
+        }
+
+        // False if the bytes are not a complete snapshot of this version; the view is then empty
+        bool valid() const { return this->valid_; }
+
+        std::size_t size() const { return this->valid_ ? this->header_.course_count : 0; }
+        std::size_t participantCount() const { return this->valid_ ? this->header_.participant_count : 0; }
+
+        // First log generation not included in the snapshot
+        std::uint32_t logGeneration() const { return this->valid_ ? this->header_.log_generation : 0; }
+
+        // Course `index` (< size())
+        CourseView operator[](std::size_t index) const
+        {
+            SnapshotCourse record;
+            std::memcpy(&record, this->bytes_.data() + this->header_.courses_offset + index * sizeof(SnapshotCourse), sizeof(record));
+            // Keep a damaged record from reaching past the participant table
+            if (record.first_participant > this->header_.participant_count)
+            {
+                record.first_participant = this->header_.participant_count;
+            }
+            record.participant_count = std::min(record.participant_count, this->header_.participant_count - record.first_participant);
+            record.waitlist_count = std::min(record.waitlist_count,
+                                             this->header_.participant_count - record.first_participant - record.participant_count);
+            return CourseView(*this, record);
+        }
+
+    private:
+        SnapshotParticipant participantRecord(std::uint32_t index) const
+        {
+            SnapshotParticipant record;
+            std::memcpy(&record, this->bytes_.data() + this->header_.participants_offset + index * sizeof(SnapshotParticipant), sizeof(record));
+            return record;
+        }
+
+        // A string from the pool; empty if the reference lies outside it
+        std::string_view text(const SnapshotString& ref) const
+        {
+            if (ref.offset > this->header_.strings_size || ref.length > this->header_.strings_size - ref.offset)
+            {
+                return std::string_view();
+            }
+            return this->bytes_.substr(this->header_.strings_offset + ref.offset, ref.length);
+        }
+
+        std::string_view bytes_; // The whole snapshot
+        SnapshotHeader header_{}; // Copy of the header
+        bool valid_ = false; // Header and tables checked
+};
+
+// Durable storage for the enrollments of a CourseCatalog, in two files:
+//
+//     <base>.wal       append-only write-ahead log, one record per change:
+//                      u32 payload length, u32 FNV-1a checksum, payload
+//                      (u8 type, u32 log generation, u32 course index, then for
+//                      REGISTER and WAITLIST i32 matriculation number, surname,
+//                      first name, email, university; for DROP the email)
+//     <base>.snapshot  all rosters at the time of the last snapshot, in the flat
+//                      format read by RosterSnapshotView
+//
+// restore() maps the snapshot, loads it and replays only the log written since.
+// A torn record at the end of the log (crash mid-write) fails its length or
+// checksum test; replay stops there and the log is truncated to the last good record.
+// Promotions from a waitlist are not logged: replaying the DROP that freed the seat
+// promotes the same student again.
+// Replay is not idempotent (replaying a DROP against rosters that already reflect it
+// frees someone else's seat), so every record carries the log generation it was
+// written in, and the snapshot header names the first generation it does not include.
+// writeSnapshot() writes the snapshot for the next generation atomically (write +
+// rename) before emptying the log; if the process dies in between, the old log's
+// records belong to an earlier generation than the snapshot and are skipped.
+class EnrollmentStore
+{
+    public:
+        // Snapshot every this many logged registrations (see snapshotDue)
+        static const std::size_t DEFAULT_SNAPSHOT_INTERVAL = 10000;
+
+        // Counts reported by restore()
+        struct RestoreStats
+        {
+            std::size_t snapshot_participants = 0; // Participants loaded from the snapshot
+            std::size_t replayed_events = 0; // Log records applied on top of it
+            std::size_t skipped_events = 0; // Log records already included in the snapshot
+            std::size_t discarded_bytes = 0; // Bytes of a torn log tail that were dropped
+        };
+
+        // `sync` makes every log append and snapshot reach the disk before returning
+        explicit EnrollmentStore(std::string base_path, bool sync = true,
+                                 std::size_t snapshot_interval = DEFAULT_SNAPSHOT_INTERVAL) :
+                 base_path_(std::move(base_path)), sync_(sync), snapshot_interval_(snapshot_interval)
+        {
+        }
+
+        ~EnrollmentStore()
+        {
+            if (this->log_ != nullptr)
+            {
+                std::fclose(this->log_);
+            }
+        }
+
+        EnrollmentStore(const EnrollmentStore&) = delete;
+        EnrollmentStore& operator=(const EnrollmentStore&) = delete;
+
+        // Load the latest snapshot and the log tail into empty courses, then open the log
+        RestoreStats restore(CourseCatalog& courses, StudentRegistry& registry)
+        {
+            RestoreStats stats;
+            {
+                MappedFile snapshot(this->snapshotPath());
+                if (snapshot.isOpen())
+                {
+                    // Room for the snapshot and a log of about one snapshot interval, so
+                    // neither the load nor the replay grows the registry
+                    const RosterSnapshotView header(snapshot.view());
+                    registry.reserve(registry.size() + header.participantCount() + this->snapshot_interval_);
+                    this->generation_ = header.logGeneration();
+                    stats.snapshot_participants = loadSnapshot(snapshot.view(), courses, registry);
+                }
+            }
+
+            std::size_t valid_length = 0;
+            std::size_t log_size = 0;
+            {
+                MappedFile log(this->logPath());
+                if (log.isOpen())
+                {
+                    log_size = log.view().size();
+                    BinaryReader reader(log.view());
+                    std::string_view payload;
+                    while (readRecord(reader, payload))
+                    {
+                        valid_length = reader.offset();
+                        if (applyRecord(payload, this->generation_, courses, registry))
+                        {
+                            ++stats.replayed_events;
+                        }
+                        else
+                        {
+                            ++stats.skipped_events;
+                        }
+                    }
+                }
+            }
+            if (valid_length < log_size)
+            {
+                std::filesystem::resize_file(this->logPath(), valid_length);
+                stats.discarded_bytes = log_size - valid_length;
+            }
+
+            this->events_since_snapshot_ = stats.replayed_events;
+            this->log_ = std::fopen(this->logPath().c_str(), "ab");
+            return stats;
+        }
+
+        // Append a registration of `student` in the course at `course_index` to the log
+        bool logRegistration(std::size_t course_index, const Student& student)
+        {
+            return this->logEvent(REGISTER_EVENT, course_index, [&student](BinaryWriter& out) { encodeStudent(out, student); });
+        }
+
+        // Append that `student` was put on the waitlist of the course at `course_index`
+        bool logWaitlisted(std::size_t course_index, const Student& student)
+        {
+            return this->logEvent(WAITLIST_EVENT, course_index, [&student](BinaryWriter& out) { encodeStudent(out, student); });
+        }
+
+        // Append that the student with `email` left the course (or its waitlist) at `course_index`
+        bool logDrop(std::size_t course_index, const std::string& email)
+        {
+            return this->logEvent(DROP_EVENT, course_index, [&email](BinaryWriter& out) { out.text(email); });
+        }
+
+        // Group commit: log appends are flushed once by endBatch() instead of one by one.
+        // Callers acknowledge the batch's registrations only once endBatch() returns true.
+        void beginBatch() { this->batching_ = true; }
+
+        bool endBatch()
+        {
+            this->batching_ = false;
+            return this->log_ == nullptr || this->flush(this->log_);
+        }
+
+        // True once enough registrations were logged that a snapshot should be taken
+        bool snapshotDue() const { return this->events_since_snapshot_ >= this->snapshot_interval_; }
+
+        // Write all rosters as the new snapshot and start an empty log of the next generation
+        bool writeSnapshot(const CourseCatalog& courses)
+        {
+            const std::string bytes = encodeRosterSnapshot(courses, this->generation_ + 1);
+            const std::string temporary = this->snapshotPath() + ".tmp";
+            std::FILE* file = std::fopen(temporary.c_str(), "wb");
+            if (file == nullptr)
+            {
+                return false;
+            }
+            const bool written = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() && this->flush(file);
+            std::fclose(file);
+            std::error_code error;
+            if (!written || (std::filesystem::rename(temporary, this->snapshotPath(), error), error))
+            {
+                return false;
+            }
+
+            // The snapshot now holds everything in the log
+            ++this->generation_;
+            if (this->log_ != nullptr)
+            {
+                std::fclose(this->log_);
+            }
+            this->log_ = std::fopen(this->logPath().c_str(), "wb");
+            this->events_since_snapshot_ = 0;
+            return this->log_ != nullptr;
+        }
+
+    private:
+        static const std::uint8_t REGISTER_EVENT = 1;
+        static const std::uint8_t WAITLIST_EVENT = 2;
+        static const std::uint8_t DROP_EVENT = 3;
+        static const std::size_t RECORD_HEADER_SIZE = 8; // Payload length + checksum
+
+        std::string snapshotPath() const { return this->base_path_ + ".snapshot"; }
+
+        // Append one record: header, event type, course index, then what `encode` writes
+        template <typename Encoder>
+        bool logEvent(std::uint8_t type, std::size_t course_index, Encoder&& encode)
+        {
+            if (this->log_ == nullptr)
+            {
+                return false;
+            }
+            this->record_.clear();
+            this->record_.u32(0); // Payload length, patched below
+            this->record_.u32(0); // Checksum, patched below
+            this->record_.u8(type);
+            this->record_.u32(this->generation_);
+            this->record_.u32(static_cast<std::uint32_t>(course_index));
+            encode(this->record_);
+
+            const std::string_view payload = this->record_.view().substr(RECORD_HEADER_SIZE);
+            this->record_.patchU32(0, static_cast<std::uint32_t>(payload.size()));
+            this->record_.patchU32(4, checksum(payload));
+
+            const std::string_view bytes = this->record_.view();
+            const bool written = std::fwrite(bytes.data(), 1, bytes.size(), this->log_) == bytes.size()
+                              && (this->batching_ || this->flush(this->log_));
+            this->events_since_snapshot_ += written;
+            return written;
+        }
+        std::string logPath() const { return this->base_path_ + ".wal"; }
+
+        // FNV-1a over a log payload
+        static std::uint32_t checksum(std::string_view data)
+        {
+            std::uint32_t h = 2166136261u;
+            for (unsigned char c : data)
+            {
+                h = (h ^ c) * 16777619u;
+            }
+            return h;
+        }
+
+        static void encodeStudent(BinaryWriter& out, const Student& student)
+        {
+            out.i32(student.getMarticulationNumber());
+            out.text(student.getSurname());
+            out.text(student.getFirstname());
+            out.text(student.getEmail());
+            out.text(student.getUniversity());
+        }
+
+        static bool decodeStudent(BinaryReader& in, std::optional<Student>& student)
+        {
+            std::int32_t matriculation_number = 0;
+            std::string_view surname, first_name, email, university;
+            if (!in.i32(matriculation_number) || !in.text(surname) || !in.text(first_name)
+                || !in.text(email) || !in.text(university))
+            {
+                return false;
+            }
+            student.emplace(std::string(surname), std::string(first_name), std::string(email), matriculation_number, university);
+            return true;
+        }
+
+        // Register a restored student, keeping the registry's course counts in step
+        static bool restoreParticipant(Course& course, Student&& student, StudentRegistry& registry)
+        {
+            if (course.tryAddOrWaitlist(std::move(student)) != AddResult::ADDED)
+            {
+                return false;
+            }
+            registry.recordEnrollment(course.getParticipants().back());
+            return true;
+        }
+
+        // Load a snapshot into the courses; returns the number of participants loaded.
+        // Each course reads its roster straight from the snapshot records (see
+        // Course::restoreRoster) rather than re-registering student by student.
+        static std::size_t loadSnapshot(std::string_view data, CourseCatalog& courses, StudentRegistry& registry)
+        {
+            const RosterSnapshotView snapshot(data);
+            std::size_t loaded = 0;
+            for (std::size_t c = 0; c < snapshot.size() && c < courses.size(); ++c)
+            {
+                const RosterSnapshotView::CourseView course = snapshot[c];
+                const std::size_t count = courses[c].restoreRoster(course.getParticipants(), course.getWaitlist());
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    registry.recordEnrollment(courses[c].getParticipants()[i]);
+                }
+                loaded += count;
+            }
+            return loaded;
+        }
+
+        // Read the next complete, intact log record
+        static bool readRecord(BinaryReader& in, std::string_view& payload)
+        {
+            std::uint32_t length = 0, expected = 0;
+            return in.u32(length) && in.u32(expected) && in.bytes(length, payload) && checksum(payload) == expected;
+        }
+
+        // Apply one log record to the courses, unless it was written before `generation`
+        // (it is then already in the snapshot). False if the record was skipped.
+        static bool applyRecord(std::string_view payload, std::uint32_t generation, CourseCatalog& courses, StudentRegistry& registry)
+        {
+            BinaryReader in(payload);
+            std::uint8_t type = 0;
+            std::uint32_t record_generation = 0;
+            std::uint32_t course_index = 0;
+            std::optional<Student> student;
+            std::string_view email;
+            if (!in.u8(type) || !in.u32(record_generation) || record_generation < generation)
+            {
+                return false;
+            }
+            if (!in.u32(course_index) || course_index >= courses.size())
+            {
+                return true;
+            }
+            if ((type == REGISTER_EVENT || type == WAITLIST_EVENT) && decodeStudent(in, student))
+            {
+                restoreParticipant(courses[course_index], std::move(*student), registry);
+            }
+            else if (type == DROP_EVENT && in.text(email))
+            {
+                dropEnrollment(courses[course_index], registry, std::string(email));
+            }
+            return true;
+        }
+
+        // Flush a file to the OS, and to the disk if sync_ is set
+        bool flush(std::FILE* file) const
+        {
+            if (std::fflush(file) != 0)
+            {
+                return false;
+            }
+#ifndef _WIN32
+            if (this->sync_)
+            {
+                return ::fsync(::fileno(file)) == 0;
+            }
+#endif
+            return true;
+        }
+
+        std::string base_path_; // Path prefix of the snapshot and log files
+        bool sync_; // fsync after every write
+        std::size_t snapshot_interval_; // Registrations between snapshots
+        std::size_t events_since_snapshot_ = 0; // Registrations logged since the last snapshot
+        std::uint32_t generation_ = 0; // Generation of the records now written to the log
+        std::FILE* log_ = nullptr; // Open log, appended to
+        bool batching_ = false; // Inside beginBatch()/endBatch()
+        BinaryWriter record_; // Encoding buffer for log records, reused
+};
+
+// Print a summary of every course in a snapshot file, read in place
+// (started with the --report <snapshot> arguments)
+bool printSnapshotReport(const std::string& path, ReportWriter& out)
+{
+    MappedFile file(path);
+    const RosterSnapshotView snapshot(file.view());
+    if (!snapshot.valid())
+    {
+        out << "Not a roster snapshot: " << path << '\n';
+        return false;
+    }
+    for (std::size_t c = 0; c < snapshot.size(); ++c)
+    {
+        const RosterSnapshotView::CourseView course = snapshot[c];
+        out << "Course: " << course.getName() << " Lecturer: " << course.getLecturerName()
+            << " Participants: " << course.getParticipantCount() << '/' << course.getMaxParticipants();
+        if (course.isFullyBooked())
+        {
+            out << " (fully booked)";
+        }
+        if (course.hasFewParticipants())
+        {
+            out << " (under minimum)";
+        }
+        out << '\n';
+        for (const auto& participant : course.getParticipants())
+        {
+            out << "  " << participant.getFirstname() << ' ' << participant.getSurname() << ", "
+                << participant.getEmail() << ", " << participant.getUniversity() << ", "
+                << participant.getMarticulationNumber() << '\n';
+        }
+    }
+    return true;
+}
+
+// Line-based command protocol for driving the registrar from another program,
+// one command per line, fields separated by spaces:
+//
+//     REGISTER <email> <first name> <surname> <university> <matriculation number> <course number>
+//         -> "OK", "WAITLISTED <position>" if the course is full, or "ERR <reason>"
+//     DROP <email> <course number>
+//         -> "OK", "OK PROMOTED <email>" if a waitlisted student got the seat, or "ERR NOT_REGISTERED"
+//     LIST  -> "COURSE <number> <participants> <max> <name>" per course, each followed by
+//              "STUDENT <email> <first name> <surname> <university> <matriculation number>"
+//              per participant, then "END"
+//     FREE  -> "COURSE <number> <free seats> <name>" per course with free seats, then "END"
+//     CLOSE -> "CANCEL <email> <course number>" per participant of a course under its
+//              minimum, then "END"; ends the session
+//     STATS [JSON] -> the Metrics as text lines then "END", or as one line of JSON
+//
+// Course numbers are 1-based, as in the menu. A '+' in a university name stands for
+// a space ("Our+University"); in responses it is written with spaces. Commands are read in large chunks and
+// every complete line of a chunk is executed before the responses to the whole chunk
+// are written with one call, so pipelining clients get one write per batch.
+class CommandProcessor
+{
+    public:
+        // Bytes read from the input per batch
+        static constexpr std::size_t READ_SIZE = 1 << 16;
+
+        CommandProcessor(CourseCatalog& courses, StudentRegistry& registry, EnrollmentStore* store = nullptr) :
+                         courses_(courses), registry_(registry), store_(store)
+        {
+        }
+
+        // Number of commands executed so far
+        std::size_t executed() const { return this->executed_; }
+
+        // True once CLOSE was executed
+        bool closed() const { return this->closed_; }
+
+        // Execute every complete line of `input`, appending the responses to `out`.
+        // Returns the number of bytes consumed; an incomplete last line is left over.
+        // With a store, the responses are held back until the batch's log records are
+        // flushed: a command whose record did not reach the log answers ERR STORE
+        // instead of its usual response.
+        std::size_t executeLines(std::string_view input, ReportWriter& out)
+        {
+            if (this->store_ == nullptr)
+            {
+                return this->executeBatch(input, out);
+            }
+
+            this->store_->beginBatch();
+            this->replies_.clear();
+            this->reply_ends_.clear();
+            const std::size_t consumed = this->executeBatch(input, this->replies_);
+            const bool flushed = this->store_->endBatch();
+            this->store_failed_ = this->store_failed_ || !flushed;
+
+            std::size_t begin = 0;
+            for (const ReplyEnd& reply : this->reply_ends_)
+            {
+                if (reply.logged && !flushed)
+                {
+                    out << "ERR STORE\n";
+                }
+                else
+                {
+                    out << this->replies_.view().substr(begin, reply.end - begin);
+                }
+                begin = reply.end;
+            }
+            if (!this->store_failed_ && (this->closed_ || this->store_->snapshotDue()))
+            {
+                this->store_->writeSnapshot(this->courses_);
+            }
+            return consumed;
+        }
+
+        // Execute commands read from `in_fd` until end of input or CLOSE,
+        // writing the responses to `out_fd`. False if writing failed.
+        bool serve(int in_fd, int out_fd)
+        {
+            std::string pending;
+            std::vector<char> chunk(READ_SIZE);
+            ReportWriter out;
+            while (!this->closed_)
+            {
+#ifdef _WIN32
+                const int received = _read(in_fd, chunk.data(), static_cast<unsigned>(chunk.size()));
+#else
+                const ssize_t received = ::read(in_fd, chunk.data(), chunk.size());
+#endif
+                if (received <= 0)
+                {
+                    // A last line without a newline still counts
+                    if (!pending.empty())
+                    {
+                        pending += '\n';
+                        this->executeLines(pending, out);
+                    }
+                    return out.flushTo(out_fd);
+                }
+                pending.append(chunk.data(), static_cast<std::size_t>(received));
+                pending.erase(0, this->executeLines(pending, out));
+                if (!out.flushTo(out_fd))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        // End of one command's response in replies_, and whether the command wrote a
+        // log record (its response then waits for the batch's flush)
+        struct ReplyEnd
+        {
+            std::size_t end;
+            bool logged;
+        };
+
+        // Execute the complete lines of `input` into `out`; returns the bytes consumed
+        std::size_t executeBatch(std::string_view input, ReportWriter& out)
+        {
+            std::size_t consumed = 0;
+            while (!this->closed_)
+            {
+                const std::size_t end = input.find('\n', consumed);
+                if (end == std::string_view::npos)
+                {
+                    break;
+                }
+                this->logged_ = false;
+                this->execute(input.substr(consumed, end - consumed), out);
+                this->reply_ends_.push_back(ReplyEnd{out.view().size(), this->logged_});
+                consumed = end + 1;
+            }
+            return consumed;
+        }
+
+        // Record that the current command changed the rosters, in the store if there is
+        // one. False (and the store is given up on) if the log record could not be written.
+        bool logged(bool written)
+        {
+            this->logged_ = written;
+            this->store_failed_ = this->store_failed_ || !written;
+            return written;
+        }
+
+        // True if REGISTER and DROP must be refused: an earlier log write or flush
+        // failed, so the log no longer matches the rosters in memory. Refusing every
+        // further change keeps the two from drifting further apart; a restart restores
+        // the state that did reach the disk.
+        bool storeUnavailable() const { return this->store_failed_; }
+
+        // Split off the next space-separated field of `line`
+        static std::string_view nextField(std::string_view& line)
+        {
+            const std::size_t start = line.find_first_not_of(" \t\r");
+            if (start == std::string_view::npos)
+            {
+                line = std::string_view();
+                return line;
+            }
+            line.remove_prefix(start);
+            const std::size_t end = std::min(line.find_first_of(" \t\r"), line.size());
+            const std::string_view field = line.substr(0, end);
+            line.remove_prefix(end);
+            return field;
+        }
+
+        // Protocol name of a registration error
+        static const char* errorName(ImportReject reason)
+        {
+            switch (reason)
+            {
+                case ImportReject::MALFORMED_ROW: return "MALFORMED";
+                case ImportReject::UNKNOWN_COURSE: return "UNKNOWN_COURSE";
+                case ImportReject::FULLY_BOOKED: return "FULLY_BOOKED";
+                case ImportReject::DUPLICATE_EMAIL: return "DUPLICATE_EMAIL";
+                case ImportReject::EXTERNAL_STUDENT_LIMIT: return "EXTERNAL_STUDENT_LIMIT";
+            }
+            return "UNKNOWN";
+        }
+
+        void execute(std::string_view line, ReportWriter& out)
+        {
+            const std::string_view command = nextField(line);
+            if (command.empty())
+            {
+                return; // Blank lines are ignored
+            }
+            ++this->executed_;
+            if (command == "REGISTER")
+            {
+                this->registerStudent(line, out);
+            }
+            else if (command == "DROP")
+            {
+                this->dropStudent(line, out);
+            }
+            else if (command == "LIST")
+            {
+                this->listCourses(out);
+            }
+            else if (command == "FREE")
+            {
+                this->listFreeSeats(out);
+            }
+            else if (command == "CLOSE")
+            {
+                this->close(out);
+            }
+            else if (command == "STATS")
+            {
+                if (nextField(line) == "JSON")
+                {
+                    Metrics::writeJson(out);
+                }
+                else
+                {
+                    Metrics::writeText(out);
+                    out << "END\n";
+                }
+            }
+            else
+            {
+                out << "ERR UNKNOWN_COMMAND\n";
+            }
+        }
+
+        void registerStudent(std::string_view fields, ReportWriter& out)
+        {
+            const std::string_view email = nextField(fields);
+            const std::string_view first_name = nextField(fields);
+            const std::string_view surname = nextField(fields);
+            const std::string_view university = nextField(fields);
+            const std::string_view matriculation_text = nextField(fields);
+            const std::string_view course_text = nextField(fields);
+            int matriculation_number = 0;
+            std::size_t course_number = 0;
+            if (course_text.empty() || !nextField(fields).empty()
+                || std::from_chars(matriculation_text.data(), matriculation_text.data() + matriculation_text.size(), matriculation_number).ec != std::errc()
+                || std::from_chars(course_text.data(), course_text.data() + course_text.size(), course_number).ec != std::errc())
+            {
+                out << "ERR " << errorName(ImportReject::MALFORMED_ROW) << '\n';
+                return;
+            }
+            if (course_number < 1 || course_number > this->courses_.size())
+            {
+                out << "ERR " << errorName(ImportReject::UNKNOWN_COURSE) << '\n';
+                return;
+            }
+
+            if (this->storeUnavailable())
+            {
+                out << "ERR STORE\n";
+                return;
+            }
+
+            std::string university_name(university);
+            std::replace(university_name.begin(), university_name.end(), '+', ' ');
+            Student student(std::string(surname), std::string(first_name), std::string(email), matriculation_number, university_name);
+            if (!this->registry_.mayEnroll(student))
+            {
+                out << "ERR " << errorName(ImportReject::EXTERNAL_STUDENT_LIMIT) << '\n';
+                return;
+            }
+            Course& course = this->courses_[course_number - 1];
+            switch (course.tryAddOrWaitlist(std::move(student)))
+            {
+                case AddResult::ADDED:
+                    this->registry_.recordEnrollment(course.getParticipants().back());
+                    if (this->store_ != nullptr && !this->logged(this->store_->logRegistration(course_number - 1, course.getParticipants().back())))
+                    {
+                        out << "ERR STORE\n";
+                        break;
+                    }
+                    out << "OK\n";
+                    break;
+                case AddResult::WAITLISTED:
+                    if (this->store_ != nullptr && !this->logged(this->store_->logWaitlisted(course_number - 1, course.getLastWaitlisted())))
+                    {
+                        out << "ERR STORE\n";
+                        break;
+                    }
+                    out << "WAITLISTED " << course.getWaitlistSize() << '\n';
+                    break;
+                case AddResult::FULLY_BOOKED:
+                    out << "ERR " << errorName(ImportReject::FULLY_BOOKED) << '\n';
+                    break;
+                case AddResult::DUPLICATE_EMAIL:
+                    out << "ERR " << errorName(ImportReject::DUPLICATE_EMAIL) << '\n';
+                    break;
+            }
+        }
+
+        void dropStudent(std::string_view fields, ReportWriter& out)
+        {
+            const std::string email(nextField(fields));
+            const std::string_view course_text = nextField(fields);
+            std::size_t course_number = 0;
+            if (course_text.empty() || !nextField(fields).empty()
+                || std::from_chars(course_text.data(), course_text.data() + course_text.size(), course_number).ec != std::errc())
+            {
+                out << "ERR " << errorName(ImportReject::MALFORMED_ROW) << '\n';
+                return;
+            }
+            if (course_number < 1 || course_number > this->courses_.size())
+            {
+                out << "ERR " << errorName(ImportReject::UNKNOWN_COURSE) << '\n';
+                return;
+            }
+
+            if (this->storeUnavailable())
+            {
+                out << "ERR STORE\n";
+                return;
+            }
+
+            const DropResult result = dropEnrollment(this->courses_[course_number - 1], this->registry_, email);
+            if (!result.dropped)
+            {
+                out << "ERR NOT_REGISTERED\n";
+                return;
+            }
+            if (this->store_ != nullptr && !this->logged(this->store_->logDrop(course_number - 1, email)))
+            {
+                out << "ERR STORE\n";
+                return;
+            }
+            out << "OK";
+            if (result.promoted != nullptr)
+            {
+                out << " PROMOTED " << result.promoted->getEmail();
+            }
+            out << '\n';
+        }
+
+        void listCourses(ReportWriter& out) const
+        {
+            for (std::size_t i = 0; i < this->courses_.size(); ++i)
+            {
+                const Course& course = this->courses_[i];
+                out << "COURSE " << i + 1 << ' ' << course.getParticipants().size() << ' '
+                    << course.getMaxParticipants() << ' ' << course.getName() << '\n';
+                for (const auto& student : course.getParticipants())
+                {
+                    out << "STUDENT " << student.getEmail() << ' ' << student.getFirstname() << ' '
+                        << student.getSurname() << ' ' << student.getUniversity() << ' '
+                        << student.getMarticulationNumber() << '\n';
+                }
+            }
+            out << "END\n";
+        }
+
+        void listFreeSeats(ReportWriter& out) const
+        {
+            for (std::size_t index : this->courses_.coursesWithAvailableSeats())
+            {
+                const Course& course = this->courses_[index];
+                out << "COURSE " << index + 1 << ' '
+                    << course.getMaxParticipants() - static_cast<int>(course.getParticipants().size()) << ' '
+                    << course.getName() << '\n';
+            }
+            out << "END\n";
+        }
+
+        void close(ReportWriter& out)
+        {
+            for (std::size_t index : this->courses_.coursesUnderMinimum())
+            {
+                for (const auto& student : this->courses_[index].getParticipants())
+                {
+                    out << "CANCEL " << student.getEmail() << ' ' << index + 1 << '\n';
+                }
+            }
+            out << "END\n";
+            this->closed_ = true;
+        }
+
+        CourseCatalog& courses_; // Courses the commands act on
+        StudentRegistry& registry_; // Course counts per student
+        EnrollmentStore* store_; // Log for registrations, if persistence is enabled
+        std::size_t executed_ = 0; // Commands executed
+        bool closed_ = false; // CLOSE received
+        ReportWriter replies_; // Responses of the current batch, held back until its log records are flushed
+        std::vector<ReplyEnd> reply_ends_; // Where each command's response ends in replies_
+        bool logged_ = false; // The command being executed wrote a log record
+        bool store_failed_ = false; // A log write or flush failed; see storeUnavailable()
+};
+
+#ifndef _WIN32
+// Accept connections on a Unix domain socket at `path` and run each through
+// `processor`, one at a time, until a client sends CLOSE
+bool serveUnixSocket(const std::string& path, CommandProcessor& processor)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+    {
+        return false;
+    }
+    ::unlink(path.c_str());
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 16) != 0)
+    {
+        ::close(listener);
+        return false;
+    }
+    while (!processor.closed())
+    {
+        const int connection = ::accept(listener, nullptr, nullptr);
+        if (connection < 0)
+        {
+            break;
+        }
+        processor.serve(connection, connection);
+        ::close(connection);
+    }
+    ::close(listener);
+    ::unlink(path.c_str());
+    return processor.closed();
+}
+#endif
+
+// Benchmark: duplicate-email detection with the hash index versus a linear scan
+void benchmarkEmailIndex(std::size_t count)
+{
+    std::vector<Student> roster;
+    roster.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        roster.emplace_back("Surname", "First", "student" + std::to_string(i) + "@uni.org",
+                            static_cast<int>(i), "Our University");
+    }
+
+    // Registration with the hash index: lookup + insert per student
+    auto start = std::chrono::steady_clock::now();
+    EmailIndex index;
+    std::size_t duplicates = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::string& email = roster[i].getEmail();
+        if (index.find(email, [&roster](int position) -> const std::string& { return roster[position].getEmail(); }) >= 0)
+        {
+            ++duplicates;
+            continue;
+        }
+        index.insert(email, static_cast<int>(i));
+    }
+    std::chrono::duration<double> indexed = std::chrono::steady_clock::now() - start;
+
+    // Registration with the previous linear scan (only on a sample, it is quadratic)
+    const std::size_t sample = std::min<std::size_t>(count, 20000);
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < sample; ++i)
+    {
+        for (std::size_t j = 0; j < i; ++j)
+        {
+            if (roster[j].getEmail() == roster[i].getEmail())
+            {
+                ++duplicates;
+                break;
+            }
+        }
+    }
+    std::chrono::duration<double> scanned = std::chrono::steady_clock::now() - start;
+
+    std::cout << count << " participants: hash index " << count / indexed.count() << " registrations/s, "
+              << "linear scan " << sample / scanned.count() << " registrations/s (first " << sample << ")"
+              << (duplicates ? " [unexpected duplicates]" : "") << "\n";
+}
+
+// Benchmark: bulk import throughput for a generated enrollment file
+void benchmarkImport(std::size_t rows)
+{
+    const std::string path = "enrollment_bench.csv";
+    const std::size_t course_count = rows / Course::DEFAULT_MAX_PARTICIPANTS + 1;
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "email,first_name,surname,university,matriculation_number,course_name\n";
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            out << "student" << i << "@uni.org,First,Surname," << (i % 10 ? "Our University" : "Other University")
+                << ',' << i << ",Course " << i % course_count << '\n';
+        }
+    }
+
+    Lecturer lecturer("Ada", "Lovelace", "ada.lovelace@uni.org", PROF);
+    std::vector<Course> courses;
+    courses.reserve(course_count);
+    for (std::size_t i = 0; i < course_count; ++i)
+    {
+        courses.emplace_back("Course " + std::to_string(i), lecturer);
+    }
+    StudentRegistry registry;
+    CourseCatalog catalog(std::move(courses));
+
+    auto start = std::chrono::steady_clock::now();
+    EnrollmentImporter importer(catalog, registry);
+    ImportReport report = importer.importFile(path);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::remove(path.c_str());
+
+    std::cout << "Import of " << report.rows << " rows: " << report.rows / elapsed.count() << " rows/s ("
+              << report.added << " added, " << report.rejects.size() << " rejected)\n";
+}
+
+// Benchmark: dumping every roster line by line with std::endl versus one buffered write
+void benchmarkRosterDump(std::size_t participant_count)
+{
+    Lecturer lecturer("Ada", "Lovelace", "ada.lovelace@uni.org", PROF);
+    std::vector<Course> courses;
+    const std::size_t course_count = participant_count / Course::DEFAULT_MAX_PARTICIPANTS;
+    courses.reserve(course_count);
+    for (std::size_t i = 0; i < course_count; ++i)
+    {
+        courses.emplace_back("Course " + std::to_string(i), lecturer);
+        for (int j = 0; j < Course::DEFAULT_MAX_PARTICIPANTS; ++j)
+        {
+            const int number = static_cast<int>(i) * Course::DEFAULT_MAX_PARTICIPANTS + j;
+            courses.back().tryAddParticipant(Student("Surname", "First", "student" + std::to_string(number) + "@uni.org",
+                                                     number, "Our University"));
+        }
+    }
+
+    const char* path = "roster_bench.txt";
+    std::ofstream out(path, std::ios::binary);
+
+    // Previous output path: one stream flush per line
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& course : courses)
+    {
+        out << "Course: " << course.getName() << " Lecturer: " << course.getLecturerName() << std::endl;
+        out << course.getLecturer().get_academic_title() << " " << lecturer.getFirstname() << " " << lecturer.getSurname()
+            << ", Email: " << lecturer.getEmail() << std::endl;
+        out << "Participants:" << std::endl;
+        for (const auto& participant : course.getParticipants())
+        {
+            out << "Name: " << participant.getFirstname() << " " << participant.getSurname()
+                << ", Email: " << participant.getEmail() << std::endl;
+            out << "University: " << participant.getUniversity()
+                << ", Matriculation Number: " << participant.getMarticulationNumber() << std::endl;
+        }
+    }
+    std::chrono::duration<double> flushed = std::chrono::steady_clock::now() - start;
+
+    // Rendered into one buffer and written once
+    start = std::chrono::steady_clock::now();
+    ReportWriter writer;
+    for (const auto& course : courses)
+    {
+        course.renderParticipants(writer);
+    }
+    writer.flushTo(out);
+    std::chrono::duration<double> buffered = std::chrono::steady_clock::now() - start;
+
+    out.close();
+    std::remove(path);
+    std::cout << "Dump of " << participant_count << " participants: std::endl " << flushed.count() * 1000 << " ms, "
+              << "buffered " << buffered.count() * 1000 << " ms\n";
+}
+
+// Benchmark: full-roster scans over Course (array of structs) and CompactCourse
+// (structure of arrays): counting external participants and searching an email
+// hash across every roster, as the cancellation and duplicate checks do.
+void benchmarkRosterLayout(std::size_t course_count)
+{
+    Lecturer lecturer("Ada", "Lovelace", "ada.lovelace@uni.org", PROF);
+    std::vector<Course> courses;
+    std::vector<CompactCourse> compact_courses;
+    courses.reserve(course_count);
+    compact_courses.reserve(course_count);
+    for (std::size_t i = 0; i < course_count; ++i)
+    {
+        courses.emplace_back("Course " + std::to_string(i), lecturer);
+        compact_courses.emplace_back("Course " + std::to_string(i), lecturer);
+        for (int j = 0; j < Course::DEFAULT_MAX_PARTICIPANTS; ++j)
+        {
+            const int number = static_cast<int>(i) * Course::DEFAULT_MAX_PARTICIPANTS + j;
+            Student student("Surname", "First", "student" + std::to_string(number) + "@uni.org",
+                            number, j % 4 ? "Our University" : "Other University " + std::to_string(j));
+            courses.back().tryAddParticipant(student);
+            compact_courses.back().tryAddParticipant(student);
+        }
+    }
+    const std::string missing = "nobody@uni.org";
+    const std::uint64_t missing_hash = EmailIndex::hash(missing);
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t aos_matches = 0;
+    for (const auto& course : courses)
+    {
+        for (const auto& participant : course.getParticipants())
+        {
+            aos_matches += !participant.isFromHomeUniversity();
+            aos_matches += EmailIndex::sameEmail(participant.getEmail(), missing);
+        }
+    }
+    std::chrono::duration<double> aos = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::size_t soa_matches = 0;
+    const std::uint32_t home = homeUniversityId();
+    for (const auto& course : compact_courses)
+    {
+        for (std::uint32_t id : course.universityIds())
+        {
+            soa_matches += id != home;
+        }
+        for (std::uint64_t hash : course.emailHashes())
+        {
+            soa_matches += hash == missing_hash;
+        }
+    }
+    std::chrono::duration<double> soa = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::size_t view_matches = 0;
+    for (const auto& course : compact_courses)
+    {
+        for (const auto participant : course.getParticipants())
+        {
+            view_matches += !participant.isFromHomeUniversity();
+            view_matches += EmailIndex::sameEmail(participant.getEmail(), missing);
+        }
+    }
+    std::chrono::duration<double> views = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Roster scan over " << course_count * Course::DEFAULT_MAX_PARTICIPANTS << " participants: "
+              << "array of structs " << aos.count() * 1000 << " ms, structure of arrays " << soa.count() * 1000 << " ms, "
+              << "participant views " << views.count() * 1000 << " ms"
+              << (aos_matches != soa_matches || aos_matches != view_matches ? " [results differ]" : "") << "\n";
+}
+
+// Benchmark: filling a 2000-seat course, into a roster that grows on demand (the
+// previous behaviour, copying every Student on each reallocation) and into a Course
+// that reserved its capacity up front
+void benchmarkLargeCourse(int seats, int rounds)
+{
+    Lecturer lecturer("Ada", "Lovelace", "ada.lovelace@uni.org", PROF);
+    std::vector<Student> students;
+    students.reserve(seats);
+    for (int i = 0; i < seats; ++i)
+    {
+        students.emplace_back("Surname", "First", "student" + std::to_string(i) + "@uni.org", i, HOME_UNIVERSITY);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t growing_total = 0;
+    for (int round = 0; round < rounds; ++round)
+    {
+        std::vector<Student> roster;
+        EmailIndex index;
+        for (const auto& student : students)
+        {
+            if (index.find(student.getEmail(), [&roster](int position) -> const std::string& { return roster[position].getEmail(); }) < 0)
+            {
+                index.insert(student.getEmail(), static_cast<int>(roster.size()));
+                roster.push_back(student);
+            }
+        }
+        growing_total += roster.size();
+    }
+    std::chrono::duration<double> growing = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    std::size_t reserved_total = 0;
+    for (int round = 0; round < rounds; ++round)
+    {
+        Course course("Lecture hall", lecturer, seats);
+        for (const auto& student : students)
+        {
+            course.tryAddParticipant(student);
+        }
+        reserved_total += course.getParticipants().size();
+    }
+    std::chrono::duration<double> reserved = std::chrono::steady_clock::now() - start;
+
+    std::cout << seats << "-seat course: growing roster " << growing_total / growing.count() << " registrations/s, "
+              << "reserved capacity " << reserved_total / reserved.count() << " registrations/s\n";
+}
+
+// Prompt for and read a student's details as entered in the menu. The university is
+// read up to the end of the line, since names such as HOME_UNIVERSITY contain spaces.
+Student readStudent(std::istream& in, std::ostream& out)
+{
+    std::string first_name, surname, email, university;
+    int matriculation_number = 0;
+    out << "\nEnter student's first name: ";
+    in >> first_name;
+    out << "\nEnter student's surname: ";
+    in >> surname;
+    out << "\nEnter student's email: ";
+    in >> email;
+    out << "\nEnter student's university: ";
+    std::getline(in >> std::ws, university);
+    out << "\nEnter student's matriculation number: ";
+    in >> matriculation_number;
+    return Student(std::move(surname), std::move(first_name), std::move(email), matriculation_number, university);
+}
+
+// Stream buffer that discards everything written to it
+class NullBuffer : public std::streambuf
+{
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// Outcome of a self test that cannot run in every build
+enum class TestResult
+{
+    PASSED,
+    FAILED,
+    SKIPPED
+};
+
+// Self test: the accessors and display() of the Person hierarchy and Course must not
+// allocate (after the thread's report buffer has grown once).
+// Allocations are only counted in builds with REGISTRAR_SELFTEST; elsewhere it is skipped.
+TestResult testDisplayAllocations()
+{
+#if !REGISTRAR_SELFTEST
+    std::cout << "Heap allocations in accessor + display() rounds: SKIPPED (build with -DREGISTRAR_SELFTEST=1)\n";
+    return TestResult::SKIPPED;
+#else
+    Course course("Software Engineering with a long course name",
+                  Lecturer("Gates", "Bill", "bill.gates@microsoft.example.com", PROF), 20);
+    for (int i = 0; i < 5; ++i)
+    {
+        course.tryAddParticipant(Student("Surname number " + std::to_string(i), "A rather long first name",
+                                         "student.number." + std::to_string(i) + "@university.example.org",
+                                         i, "Other University of Somewhere"));
+    }
+    const Student& student = course.getParticipants().front();
+
+    NullBuffer discard;
+    std::ostream out(&discard);
+    student.display(out); // Warm up the thread's report buffer
+    course.getLecturer().display(out);
+
+    const std::size_t before = heap_allocation_count;
+    std::size_t length = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        length += student.getSurname().size() + student.getFirstname().size() + student.getEmail().size()
+                + student.getUniversity().size() + course.getName().size() + course.getCourseName().size()
+                + course.getLecturerName().size() + course.getLecturer().getEmail().size();
+        student.display(out);
+        course.getLecturer().display(out);
+    }
+    const std::size_t allocations = heap_allocation_count - before;
+
+    std::cout << "Heap allocations in 1000 accessor + display() rounds: " << allocations
+              << (allocations == 0 && length > 0 ? " - PASS" : " - FAIL") << "\n";
+    return allocations == 0 && length > 0 ? TestResult::PASSED : TestResult::FAILED;
+#endif
+}
+
+// Random registrations and drops on a small course, checked against a plain set:
+// every email must be found exactly where the roster holds it, and nowhere else
+bool testRosterChurn()
+{
+    const int seats = 64;
+    Course course("Churn", Lecturer("Lovelace", "Ada", "ada@uni.org", PROF), seats);
+    std::set<std::string> expected;
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> pick(0, 4 * seats - 1);
+    bool ok = true;
+    for (int round = 0; round < 20000 && ok; ++round)
+    {
+        const std::string email = "Student" + std::to_string(pick(generator)) + "@uni.org";
+        if (generator() % 2 == 0)
+        {
+            const AddResult result = course.tryAddParticipant(Student("S", "F", email, round, HOME_UNIVERSITY));
+            ok = result == (expected.size() >= static_cast<std::size_t>(seats) ? AddResult::FULLY_BOOKED
+                            : expected.count(email) ? AddResult::DUPLICATE_EMAIL : AddResult::ADDED);
+            if (result == AddResult::ADDED)
+            {
+                expected.insert(email);
+            }
+        }
+        else
+        {
+            ok = course.dropParticipant(email).dropped == (expected.erase(email) == 1);
+        }
+
+        ok = ok && course.getParticipants().size() == expected.size();
+        for (std::size_t i = 0; ok && i < course.getParticipants().size(); ++i)
+        {
+            ok = course.findParticipant(course.getParticipants()[i].getEmail()) == static_cast<int>(i);
+        }
+    }
+    for (int i = 0; ok && i < 4 * seats; ++i)
+    {
+        const std::string email = "student" + std::to_string(i) + "@UNI.org"; // Lookups ignore case
+        ok = (course.findParticipant(email) >= 0) == (expected.count("Student" + std::to_string(i) + "@uni.org") == 1);
+    }
+
+    std::cout << "Roster add/drop churn against a reference set: " << (ok ? "PASS" : "FAIL") << "\n";
+    return ok;
+}
+
+// Catalog of `course_count` courses that will not take place, each holding two of
+// `course_count` * 2 / 3 students, so most students sit in about three of them.
+// Every other course gets the emails in upper case, which must still match.
+std::vector<Course> makeCancelledCourses(std::size_t course_count)
+{
+    const std::size_t student_count = std::max<std::size_t>(1, course_count * 2 / 3);
+    std::vector<Course> courses;
+    courses.reserve(course_count);
+    std::mt19937 generator(11);
+    for (std::size_t c = 0; c < course_count; ++c)
+    {
+        courses.emplace_back("Course " + std::to_string(c), Lecturer("Lovelace", "Ada", "ada@uni.org", PROF));
+        for (int seat = 0; seat < 2; ++seat)
+        {
+            const std::size_t s = generator() % student_count;
+            std::string email = "student" + std::to_string(s) + "@uni.org";
+            if (c % 2 == 1)
+            {
+                std::transform(email.begin(), email.end(), email.begin(), [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
+            }
+            courses.back().tryAddParticipant(Student("Surname", "First", std::move(email), static_cast<int>(s), HOME_UNIVERSITY));
+        }
+    }
+    return courses;
+}
+
+// The parallel cancellation notices must not depend on the thread count, and must
+// reach every affected student exactly once
+bool testCancellationNotices()
+{
+    CourseCatalog courses(makeCancelledCourses(3000));
+    std::set<std::string> students;
+    for (const auto& course : courses)
+    {
+        for (const auto& participant : course.getParticipants())
+        {
+            std::string email = participant.getEmail();
+            std::transform(email.begin(), email.end(), email.begin(), [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+            students.insert(email);
+        }
+    }
+
+    ReportWriter serial, parallel;
+    const std::size_t serial_count = CancellationNotifier(courses, 1).render(serial);
+    const std::size_t parallel_count = CancellationNotifier(courses, 8).render(parallel);
+    const bool ok = serial_count == students.size() && parallel_count == serial_count && serial.view() == parallel.view();
+
+    std::cout << "Cancellation notices, 1 vs 8 threads: " << parallel_count << " students - " << (ok ? "PASS" : "FAIL") << "\n";
+    return ok;
+}
+
+// Waitlist behaviour as seen through the menu's registration call
+bool testWaitlist()
+{
+    const Metrics::Totals before = Metrics::collect();
+    Course course("Seminar", Lecturer("Hopper", "Grace", "grace@uni.org", PROF), 1);
+    std::ostringstream messages;
+    std::streambuf* const console = std::cout.rdbuf(messages.rdbuf());
+    course.addParticipant(Student("A", "Ann", "ann@uni.org", 1, HOME_UNIVERSITY));
+    course.addParticipant(Student("B", "Bob", "bob@uni.org", 2, HOME_UNIVERSITY));
+    std::cout.rdbuf(console);
+
+    bool ok = course.getWaitlistSize() == 1
+           && messages.str().find("email: bob@uni.org is number 1 on the waitlist") != std::string::npos;
+
+    // Emails differing only in case are the same student, on the waitlist as on the roster
+    ok = ok && course.tryAddOrWaitlist(Student("B", "Bob", "BOB@UNI.ORG", 2, HOME_UNIVERSITY)) == AddResult::DUPLICATE_EMAIL
+            && course.tryAddOrWaitlist(Student("A", "Ann", "Ann@Uni.org", 1, HOME_UNIVERSITY)) == AddResult::DUPLICATE_EMAIL
+            && course.tryAddOrWaitlist(Student("C", "Cy", "cy@uni.org", 3, HOME_UNIVERSITY)) == AddResult::WAITLISTED
+            && course.getWaitlistSize() == 2 && course.getWaitlistPosition("CY@uni.org") == 2;
+    const DropResult waiting = course.dropParticipant("bob@UNI.org", [](const Student&) { return true; });
+    ok = ok && waiting.dropped && !waiting.was_participant && course.getWaitlistSize() == 1;
+    const DropResult seated = course.dropParticipant("ANN@uni.org", [](const Student&) { return true; });
+    ok = ok && seated.dropped && seated.was_participant && seated.promoted
+            && seated.promoted->getEmail() == "cy@uni.org" && course.getWaitlistSize() == 0;
+
+#if REGISTRAR_METRICS
+    // Waitlisted requests count as waitlisted only, not as rejected for a full course
+    const Metrics::Totals after = Metrics::collect();
+    const auto counted = [&](MetricCounter counter)
+    {
+        const std::size_t c = static_cast<std::size_t>(counter);
+        return after.counters[c] - before.counters[c];
+    };
+    ok = ok && counted(MetricCounter::WAITLISTED) == 2 && counted(MetricCounter::FULLY_BOOKED) == 0;
+#endif
+
+    // Positions stay right while entries of students who left the waitlist are compacted away
+    for (int i = 0; i < 1000; ++i)
+    {
+        const std::string email = "student" + std::to_string(i) + "@uni.org";
+        course.tryAddOrWaitlist(Student("S", "Sam", email, 10 + i, HOME_UNIVERSITY));
+        if (i > 0)
+        {
+            course.dropParticipant(email, [](const Student&) { return true; });
+        }
+    }
+    std::size_t entries = 0;
+    course.forEachWaitlisted([&](const Student&) { ++entries; });
+    ok = ok && course.getWaitlistSize() == 1 && entries == 1
+            && course.tryAddOrWaitlist(Student("D", "Dee", "dee@uni.org", 4, HOME_UNIVERSITY)) == AddResult::WAITLISTED
+            && course.getWaitlistPosition("student0@uni.org") == 1 && course.getWaitlistPosition("dee@uni.org") == 2;
+
+    std::cout << "Waitlist: " << (ok ? "PASS" : "FAIL") << "\n";
+    return ok;
+}
+
+// Students entered through the menu: one from the home university may take two
+// courses, one from another university only the first
+bool testMenuUniversityLimit()
+{
+    std::istringstream input("Ada\nLovelace\nada@uni.org\nOur University\n1\n"
+                             "Alan\nTuring\nalan@other.org\nOther University\n2\n");
+    NullBuffer discard;
+    std::ostream prompts(&discard);
+    const Student home = readStudent(input, prompts);
+    const Student external = readStudent(input, prompts);
+
+    Lecturer lecturer("Hopper", "Grace", "grace@uni.org", PROF);
+    std::vector<Course> courses;
+    courses.emplace_back("Compilers", lecturer);
+    courses.emplace_back("Databases", lecturer);
+    StudentRegistry registry;
+    std::vector<bool> admitted;
+    for (const Student* student : {&home, &external})
+    {
+        for (Course& course : courses)
+        {
+            const bool may_enroll = registry.mayEnroll(*student);
+            if (may_enroll && course.tryAddParticipant(Student(*student)) == AddResult::ADDED)
+            {
+                registry.recordEnrollment(*student);
+            }
+            admitted.push_back(may_enroll);
+        }
+    }
+    const bool ok = home.getUniversity() == HOME_UNIVERSITY && home.isFromHomeUniversity()
+                 && admitted == std::vector<bool>{true, true, true, false}
+                 && courses[0].getParticipants().size() == 2 && courses[1].getParticipants().size() == 1;
+
+    std::cout << "Home student takes two courses through the menu input: " << (ok ? "PASS" : "FAIL") << "\n";
+    return ok;
+}
+
+// Command responses must not acknowledge a change whose log record did not reach the
+// store: an append that fails (the log cannot be opened) and a flush that fails (the
+// log is /dev/full, where it is available) both answer ERR STORE, and every later
+// change is refused while reads still work
+bool testCommandAcknowledgement()
+{
+    const auto makeCatalog = []()
+    {
+        std::vector<Course> courses;
+        courses.emplace_back("Seminar", Lecturer("Hopper", "Grace", "grace@uni.org", PROF), 1);
+        return courses;
+    };
+    const std::string_view batch = "REGISTER ann@uni.org Ann A Our+University 1 1\nREGISTER bob@uni.org Bob B Our+University 2 1\nFREE\n";
+    bool ok = true;
+    {
+        CourseCatalog courses(makeCatalog());
+        StudentRegistry registry;
+        EnrollmentStore store("selftest_missing_directory/enrollments", false);
+        store.restore(courses, registry);
+        CommandProcessor processor(courses, registry, &store);
+        ReportWriter out;
+        processor.executeLines(batch, out);
+        ok = out.view() == "ERR STORE\nERR STORE\nEND\n";
+    }
+
+    const std::string base = "selftest_acknowledgement";
+    std::error_code error;
+    std::filesystem::remove(base + ".wal", error);
+    std::filesystem::create_symlink("/dev/full", base + ".wal", error);
+    if (!error && std::filesystem::exists("/dev/full"))
+    {
+        CourseCatalog courses(makeCatalog());
+        StudentRegistry registry;
+        EnrollmentStore store(base, false);
+        store.restore(courses, registry);
+        CommandProcessor processor(courses, registry, &store);
+        ReportWriter out;
+        processor.executeLines("FREE\nREGISTER ann@uni.org Ann A Our+University 1 1\n", out);
+        processor.executeLines("DROP ann@uni.org 1\n", out);
+        ok = ok && out.view() == "COURSE 1 1 Seminar\nEND\nERR STORE\nERR STORE\n";
+    }
+    std::filesystem::remove(base + ".wal", error);
+    std::filesystem::remove(base + ".snapshot", error);
+
+    {
+        CourseCatalog courses(makeCatalog());
+        StudentRegistry registry;
+        EnrollmentStore store(base, false);
+        store.restore(courses, registry);
+        CommandProcessor processor(courses, registry, &store);
+        ReportWriter out;
+        processor.executeLines(batch, out);
+        ok = ok && out.view() == "OK\nWAITLISTED 1\nEND\n";
+    }
+    std::filesystem::remove(base + ".wal", error);
+    std::filesystem::remove(base + ".snapshot", error);
+
+    std::cout << "Command responses wait for the log: " << (ok ? "PASS" : "FAIL") << "\n";
+    return ok;
+}
+
+// A crash after writeSnapshot() renamed the new snapshot into place but before it
+// emptied the log leaves the old log behind. Restoring must skip that log instead of
+// replaying its DROP against rosters that already reflect it (which would free the
+// seat of whoever holds it now and promote the waitlist again).
+bool testSnapshotCrashRecovery()
+{
+    const std::string base = "selftest_crash";
+    const auto makeCatalog = []()
+    {
+        std::vector<Course> courses;
+        courses.emplace_back("Seminar", Lecturer("Hopper", "Grace", "grace@uni.org", PROF), 1);
+        return courses;
+    };
+    std::error_code error;
+    std::filesystem::remove(base + ".wal", error);
+    std::filesystem::remove(base + ".snapshot", error);
+    {
+        CourseCatalog courses(makeCatalog());
+        StudentRegistry registry;
+        EnrollmentStore store(base, false);
+        store.restore(courses, registry);
+        CommandProcessor processor(courses, registry, &store);
+        ReportWriter out;
+        processor.executeLines("REGISTER ann@uni.org Ann A Our+University 1 1\nDROP ann@uni.org 1\n"
+                               "REGISTER ann@uni.org Ann A Our+University 1 1\nREGISTER bob@uni.org Bob B Our+University 2 1\n", out);
+
+        // Keep the log as it was before the snapshot, and put it back afterwards
+        std::filesystem::copy_file(base + ".wal", base + ".wal.old", std::filesystem::copy_options::overwrite_existing, error);
+        store.writeSnapshot(courses);
+    }
+    std::filesystem::rename(base + ".wal.old", base + ".wal", error);
+
+    CourseCatalog courses(makeCatalog());
+    StudentRegistry registry;
+    EnrollmentStore store(base, false);
+    const EnrollmentStore::RestoreStats stats = store.restore(courses, registry);
+    const bool ok = !error && stats.snapshot_participants == 1 && stats.replayed_events == 0 && stats.skipped_events == 4
+                 && courses[0].getParticipants().size() == 1 && courses[0].getParticipants()[0].getEmail() == "ann@uni.org"
+                 && courses[0].getWaitlistPosition("bob@uni.org") == 1
+                 && registry.getCourseCount("ann@uni.org") == 1 && registry.getCourseCount("bob@uni.org") == 0;
+    std::filesystem::remove(base + ".wal", error);
+    std::filesystem::remove(base + ".snapshot", error);
+
+    std::cout << "Restore after a crash between snapshot and log truncation: " << (ok ? "PASS" : "FAIL") << "\n";
+    return ok;
+}
+
+// Run the self tests (started with the --selftest argument)
+bool runSelfTests()
+{
+    std::vector<TestResult> results;
+    results.push_back(testDisplayAllocations());
+    for (bool (*test)() : { testRosterChurn, testCancellationNotices, testMenuUniversityLimit, testWaitlist,
+                            testCommandAcknowledgement, testSnapshotCrashRecovery })
+    {
+        results.push_back(test() ? TestResult::PASSED : TestResult::FAILED);
+    }
+
+    const auto count = [&results](TestResult result) { return std::count(results.begin(), results.end(), result); };
+    std::cout << "Self tests: " << count(TestResult::PASSED) << " passed, " << count(TestResult::FAILED) << " failed, "
+              << count(TestResult::SKIPPED) << " skipped\n";
+    return count(TestResult::FAILED) == 0;
+}
 
-        // Getter for email
-        std::string getEmail() const { return this->email_; }
+// Benchmark: rendering `count` records through the virtual Person::render versus the
+// statically dispatched paths (final Student by value, and std::variant records)
+void benchmarkDispatch(std::size_t count)
+{
+    std::vector<std::unique_ptr<Person>> polymorphic;
+    std::vector<Student> students;
+    std::vector<PersonRecord> records;
+    polymorphic.reserve(count);
+    students.reserve(count);
+    records.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Student student("Surname", "First", "s" + std::to_string(i) + "@uni.org", static_cast<int>(i), HOME_UNIVERSITY);
+        polymorphic.push_back(std::make_unique<Student>(student));
+        records.emplace_back(student);
+        students.push_back(std::move(student));
+    }
 
-        // Virtual method to display the Person's information
-        virtual void display() const 
-        {
-            std::cout << "Name: " << this->getFirstname() << " " << this->getSurname() 
-                      << ", Email: " << this->getEmail() << std::endl;
-        }
+    ReportWriter writer;
+    auto timeRendering = [&writer](auto render)
+    {
+        writer.clear();
+        const auto start = std::chrono::steady_clock::now();
+        render();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() * 1000;
+    };
 
-    protected:
-        std::string surname_; // Person's surname
-        std::string first_name_; // Person's first name
-        std::string email_; // Person's email address
-};
+    // Warm up the writer's buffer so every variant writes into the same capacity
+    renderPeople(students, writer);
 
-// Enumeration for academic titles of lecturers
-enum Title
-{
-    DR = 1U,
-    ASSISS_PROF,
-    ASSOC_PROF,
-    PROF
-};
+    const double virtual_ms = timeRendering([&]() { for (const auto& person : polymorphic) { person->render(writer); } });
+    const double static_ms = timeRendering([&]() { renderPeople(students, writer); });
+    const double variant_ms = timeRendering([&]() { for (const auto& record : records) { renderPerson(record, writer); } });
+
+    std::cout << "Rendering " << count << " records: virtual " << virtual_ms << " ms, static (final) " << static_ms
+              << " ms, std::variant " << variant_ms << " ms\n";
+}
 
-// Derived class for Lecturer, inheriting from Person
-class Lecturer : public Person
+// Benchmark: restart time of an EnrollmentStore holding `count` enrollments in its
+// snapshot plus a log tail of `tail` registrations
+void benchmarkStoreRestore(std::size_t count, std::size_t tail)
 {
-    public:
-        // Constructor to initialize a Lecturer with surname, first name, email, and academic title
-        Lecturer(const std::string& surname, const std::string& first_name, const std::string& email, Title academic_title) : 
-                        Person(surname, first_name, email), academic_title_(academic_title)
+    const std::string base = "enrollment_store_bench";
+    const std::size_t course_count = (count + tail) / Course::DEFAULT_MAX_PARTICIPANTS + 1;
+    auto makeCatalog = [course_count]()
+    {
+        std::vector<Course> courses;
+        courses.reserve(course_count);
+        for (std::size_t i = 0; i < course_count; ++i)
         {
+            courses.emplace_back("Course " + std::to_string(i), Lecturer("Lovelace", "Ada", "ada@uni.org", PROF));
         }
+        return courses;
+    };
 
-        // Getter for academic title
-        Title get_academic_title()
+    {
+        CourseCatalog courses(makeCatalog());
+        StudentRegistry registry;
+        EnrollmentStore store(base, false);
+        store.restore(courses, registry);
+        for (std::size_t i = 0; i < count + tail; ++i)
         {
-            return this->academic_title_;
+            if (i == count)
+            {
+                store.writeSnapshot(courses);
+            }
+            Student student("Surname", "First", "student" + std::to_string(i) + "@uni.org", static_cast<int>(i), HOME_UNIVERSITY);
+            const std::size_t course = i / Course::DEFAULT_MAX_PARTICIPANTS;
+            if (courses[course].tryAddParticipant(std::move(student)) == AddResult::ADDED && i >= count)
+            {
+                store.logRegistration(course, courses[course].getParticipants().back());
+            }
         }
+    }
 
-        // Overridden display method to include academic title
-        void display() const override 
+    // Analytics-style scan straight over the mapped snapshot
+    const auto scan_start = std::chrono::steady_clock::now();
+    std::size_t full_courses = 0, external_students = 0;
+    {
+        MappedFile file(base + ".snapshot");
+        const RosterSnapshotView snapshot(file.view());
+        for (std::size_t c = 0; c < snapshot.size(); ++c)
         {
-            std::cout << this->academic_title_ << " " << this->getFirstname() << " " << this->getSurname() 
-                      << ", Email: " << this->getEmail() << std::endl;
+            full_courses += snapshot[c].isFullyBooked();
+            for (const auto& participant : snapshot[c].getParticipants())
+            {
+                external_students += !participant.isFromHomeUniversity();
+            }
         }
+    }
+    const std::chrono::duration<double> scan_elapsed = std::chrono::steady_clock::now() - scan_start;
 
-    private:
-        Title academic_title_; // Lecturer's academic title
+    CourseCatalog courses(makeCatalog());
+    StudentRegistry registry;
+    const auto start = std::chrono::steady_clock::now();
+    EnrollmentStore store(base, false);
+    const EnrollmentStore::RestoreStats stats = store.restore(courses, registry);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::remove((base + ".snapshot").c_str());
+    std::remove((base + ".wal").c_str());
+
+    std::cout << "Restart with " << stats.snapshot_participants << " snapshot enrollments + "
+              << stats.replayed_events << " log records: " << elapsed.count() * 1000 << " ms\n";
+    std::cout << "Snapshot scan in place (" << full_courses << " full courses, " << external_students
+              << " external students): " << scan_elapsed.count() * 1000 << " ms\n";
+}
+
+// Benchmark: REGISTER commands pipelined through CommandProcessor in batches
+void benchmarkCommandProtocol(std::size_t count)
+{
+    std::vector<Course> course_list;
+    course_list.reserve(count / Course::DEFAULT_MAX_PARTICIPANTS + 1);
+    for (std::size_t i = 0; i <= count / Course::DEFAULT_MAX_PARTICIPANTS; ++i)
+    {
+        course_list.emplace_back("Course" + std::to_string(i), Lecturer("Lovelace", "Ada", "ada@uni.org", PROF));
+    }
+    CourseCatalog courses(std::move(course_list));
+    StudentRegistry registry;
+    CommandProcessor processor(courses, registry);
+
+    ReportWriter input;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        input << "REGISTER student" << i << "@uni.org First Surname Other " << static_cast<long long>(i) << ' '
+              << i / Course::DEFAULT_MAX_PARTICIPANTS + 1 << '\n';
+    }
+
+    ReportWriter out;
+    const auto start = std::chrono::steady_clock::now();
+    std::string_view pending = input.view();
+    while (!pending.empty())
+    {
+        const std::size_t batch = std::min(pending.size(), CommandProcessor::READ_SIZE);
+        const std::size_t consumed = processor.executeLines(pending.substr(0, batch), out);
+        pending.remove_prefix(consumed);
+        out.clear();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Command protocol: " << processor.executed() << " REGISTER commands (" << registry.size() << " accepted) in "
+              << elapsed.count() * 1000 << " ms, " << processor.executed() / elapsed.count() << " ops/s\n";
+}
+
+// Parameters of a synthetic registration workload (see runLoadBenchmark)
+struct WorkloadConfig
+{
+    std::size_t requests = 1000000; // Registration requests to issue
+    std::size_t courses = 2000; // Courses on offer
+    int course_capacity = 200; // Seats per course
+    double zipf_exponent = 1.0; // Skew of course popularity; 0 makes every course equally popular
+    std::size_t courses_per_student = 3; // Average requests per student
+    double external_rate = 0.2; // Share of students from other universities
+    double duplicate_rate = 0.05; // Share of requests that retry an earlier request
+    std::uint32_t seed = 42; // Random seed, for reproducible runs
 };
 
-// Derived class for Student, inheriting from Person
-class Student : public Person
+// Draws course indices with Zipf-distributed popularity: course k is chosen with
+// probability proportional to 1 / (k + 1)^exponent
+class ZipfDistribution
 {
     public:
-        // Constructor to initialize a Student with additional matriculation number and university
-        Student(const std::string& surname, const std::string& first_name, const std::string& email, int marticulation_number, const std::string& university) : 
-        Person(surname, first_name, email), marticulation_number_(marticulation_number), university_(university)
+        ZipfDistribution(std::size_t count, double exponent)
         {
+            this->cumulative_.reserve(count);
+            double total = 0.0;
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                total += 1.0 / std::pow(static_cast<double>(k + 1), exponent);
+                this->cumulative_.push_back(total);
+            }
+            for (double& value : this->cumulative_)
+            {
+                value /= total;
+            }
         }
 
-        // Getter for university name
-        std::string getUniversity() const { return this->university_; }
-        
-        // Getter for matriculation number
-        int getMarticulationNumber() const { return this->marticulation_number_; }
-
-        // Overridden display method to include university and matriculation number
-        void display() const override 
+        template <typename Generator>
+        std::size_t operator()(Generator& generator) const
         {
-            Person::display();
-            std::cout << "University: " << this->getUniversity() 
-                      << ", Matriculation Number: " << this->getMarticulationNumber() << std::endl;
+            const double u = std::uniform_real_distribution<double>(0.0, 1.0)(generator);
+            const auto it = std::lower_bound(this->cumulative_.begin(), this->cumulative_.end(), u);
+            return std::min(static_cast<std::size_t>(it - this->cumulative_.begin()), this->cumulative_.size() - 1);
         }
 
     private:
-        int marticulation_number_; // Student's matriculation number
-        std::string university_; // Name of the university the student is enrolled in
+        std::vector<double> cumulative_; // Cumulative probability of courses 0..k
 };
 
-// Class for a Course
-class Course
+// Load generator and latency benchmark for the registration path. The requests are
+// generated up front; each one is then timed from building the Student to the end of
+// its registration (the registry's external student check, Course::tryAddParticipant
+// and the registry update, as in the menu). Prints throughput, the outcome of the
+// requests and latency percentiles.
+void runLoadBenchmark(const WorkloadConfig& config)
 {
-    public:
-        // Constructor to initialize a Course with a name and a Lecturer
-        Course(const std::string& name, const Lecturer& lecturer) : name_(name), lecturer_(lecturer)
-        {
-        }
+    // A request: who registers for which course
+    struct Request
+    {
+        std::uint32_t student;
+        std::uint32_t course;
+    };
 
-        // Constants for maximum and minimum participants in a course
-        static const int MAX_PARTICIPANTS = 10;
-        static const int MIN_PARTICIPANTS = 3;
+    std::mt19937 generator(config.seed);
+    const ZipfDistribution popularity(config.courses, config.zipf_exponent);
+    const std::size_t student_count = std::max<std::size_t>(1, config.requests / std::max<std::size_t>(1, config.courses_per_student));
+    std::uniform_int_distribution<std::size_t> pick_student(0, student_count - 1);
+    std::bernoulli_distribution is_duplicate(config.duplicate_rate);
 
-        // Getter for course name
-        std::string getCourseName() const
+    std::vector<Request> requests;
+    requests.reserve(config.requests);
+    for (std::size_t i = 0; i < config.requests; ++i)
+    {
+        if (!requests.empty() && is_duplicate(generator))
         {
-            return this->name_;
+            std::uniform_int_distribution<std::size_t> earlier(0, requests.size() - 1);
+            requests.push_back(requests[earlier(generator)]); // Retry of an earlier request
         }
-
-        // Getter for the lecturer's name
-        std::string getLecturerName() const
+        else
         {
-            return this->lecturer_.getSurname();
+            requests.push_back(Request{static_cast<std::uint32_t>(pick_student(generator)),
+                                       static_cast<std::uint32_t>(popularity(generator))});
         }
+    }
 
-        // Getter for course name
-        std::string getName() const { return this->name_; }
-        
-        // Getter for the Lecturer object
-        Lecturer getLecturer() const { return this->lecturer_; }
-        
-        // Getter for the list of participants
-        const std::vector<Student>& getParticipants() const { return participants; }
+    std::vector<std::string> emails(student_count);
+    std::vector<bool> external(student_count);
+    std::bernoulli_distribution is_external(config.external_rate);
+    for (std::size_t s = 0; s < student_count; ++s)
+    {
+        emails[s] = "student" + std::to_string(s) + "@uni.org";
+        external[s] = is_external(generator);
+    }
 
-        // Check if the course is fully booked
-        bool isFullyBooked() const
-        {
-            return participants.size() >= MAX_PARTICIPANTS;
-        }
+    const int min_participants = config.course_capacity < Course::DEFAULT_MIN_PARTICIPANTS
+                               ? config.course_capacity : Course::DEFAULT_MIN_PARTICIPANTS;
+    std::vector<Course> course_list;
+    course_list.reserve(config.courses);
+    for (std::size_t c = 0; c < config.courses; ++c)
+    {
+        course_list.emplace_back("Course " + std::to_string(c), Lecturer("Lovelace", "Ada", "ada@uni.org", PROF),
+                                 config.course_capacity, min_participants);
+    }
+    CourseCatalog courses(std::move(course_list));
+    StudentRegistry registry;
+    const std::string external_university = "Other University";
 
-        // Add a participant to the course
-        bool addParticipant(const Student& student)
+    std::vector<std::uint32_t> latencies; // Nanoseconds per request
+    latencies.reserve(requests.size());
+    std::size_t added = 0, fully_booked = 0, duplicates = 0, external_limit = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (const Request& request : requests)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        Student student("Surname", "First", emails[request.student], static_cast<int>(request.student),
+                        external[request.student] ? external_university : HOME_UNIVERSITY);
+        AddResult result = AddResult::ADDED;
+        const bool allowed = registry.mayEnroll(student);
+        if (allowed)
         {
-            // Check if the course is already fully booked
-            if (isFullyBooked()) 
-            {
-                std::cout << "Course is already fully booked." << std::endl;
-                return false;
-            }
-            
-            // Ensure no duplicate email exists for participants
-            for(const auto& participant : participants)
+            Course& course = courses[request.course];
+            result = course.tryAddParticipant(std::move(student));
+            if (result == AddResult::ADDED)
             {
-                if(student.getEmail() == participant.getEmail())
-                {
-                    return false;
-                }
+                registry.recordEnrollment(course.getParticipants().back());
             }
-            
-            // Add the student to the participants list
-            participants.push_back(student);
-            std::cout << "The Student with email: " << student.getEmail() 
-                      << " was successfully added! " << std::endl;
-            return true;
         }
+        const auto end = std::chrono::steady_clock::now();
+        external_limit += !allowed;
+        added += allowed && result == AddResult::ADDED;
+        fully_booked += allowed && result == AddResult::FULLY_BOOKED;
+        duplicates += allowed && result == AddResult::DUPLICATE_EMAIL;
+        latencies.push_back(static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count()));
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
 
-        // Display all participants of the course
-        void displayParticipants() const
-        {
-            std::cout << "Course: " << this->getName() 
-                      << " Lecturer: " << this->getLecturerName() << std::endl;
-            this->lecturer_.display();
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p)
+    {
+        return latencies.empty() ? 0u : latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * latencies.size()))];
+    };
 
-            if (participants.size() < MIN_PARTICIPANTS) 
-            {
-                std::cout << "Course will not take place due to insufficient participants." << std::endl;
-            } 
-            else 
-            {
-                std::cout << "Participants:" << std::endl;
-                for (const auto& participant : participants)
-                {
-                    participant.display();
-                }
-            }
-        }
+    std::cout << "Load: " << requests.size() << " requests, " << config.courses << " courses x " << config.course_capacity
+              << " seats, Zipf " << config.zipf_exponent << ": " << requests.size() / elapsed.count() << " requests/s\n"
+              << "  added " << added << ", fully booked " << fully_booked << ", duplicate email " << duplicates
+              << ", external student limit " << external_limit << '\n'
+              << "  latency p50 " << percentile(0.50) << " ns, p99 " << percentile(0.99) << " ns, p99.9 "
+              << percentile(0.999) << " ns, max " << (latencies.empty() ? 0u : latencies.back()) << " ns\n";
+}
 
-        // Display available seats in the course
-        void displayAvailableSeats() const 
-        {
-            std::cout << "Course: " << this->getName() << ", Lecturer: ";
-            this->lecturer_.display();
-            std::cout << "Available seats: " << (MAX_PARTICIPANTS - participants.size()) << std::endl;
-        }
+// Benchmark: `waiting` requests queue up for a full course, then seats are dropped
+// one at a time and the head of the waitlist is promoted into each
+void benchmarkWaitlist(int seats, std::size_t waiting)
+{
+    Course course("Popular course", Lecturer("Lovelace", "Ada", "ada@uni.org", PROF), seats);
+    std::vector<std::string> emails;
+    emails.reserve(seats + waiting);
+    for (std::size_t i = 0; i < seats + waiting; ++i)
+    {
+        emails.push_back("student" + std::to_string(i) + "@uni.org");
+    }
 
-        // Check if the course has fewer participants than the minimum required
-        bool hasFewParticipants() const 
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < emails.size(); ++i)
+    {
+        course.tryAddOrWaitlist(Student("Surname", "First", emails[i], static_cast<int>(i), HOME_UNIVERSITY));
+    }
+    const auto queued = std::chrono::steady_clock::now();
+    std::size_t promoted = 0;
+    for (std::size_t i = 0; i < waiting; ++i)
+    {
+        promoted += course.dropParticipant(emails[i]).promoted != nullptr;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const std::chrono::duration<double> queueing = queued - start;
+    const std::chrono::duration<double> dropping = end - queued;
+    std::cout << seats << "-seat course with " << waiting << " waiting: " << emails.size() / queueing.count()
+              << " requests/s queued, " << waiting / dropping.count() << " drops/s (" << promoted << " promoted)\n";
+}
+
+// Benchmark: end-of-term notices for `course_count` cancelled courses, rendered per
+// course and participant as the menu used to, and through CancellationNotifier
+void benchmarkCancellationNotices(std::size_t course_count)
+{
+    CourseCatalog courses(makeCancelledCourses(course_count));
+    ReportWriter out;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t index : courses.coursesUnderMinimum())
+    {
+        for (const auto& participant : courses[index].getParticipants())
         {
-            return participants.size() < MIN_PARTICIPANTS;
+            participant.render(out);
         }
+    }
+    const std::chrono::duration<double> per_course = std::chrono::steady_clock::now() - start;
+    out.clear();
 
-    private:
-        std::string name_; // Name of the course
-        Lecturer lecturer_; // Lecturer for the course
-        std::vector<Student> participants; // List of participants in the course
-};
+    std::cout << "Cancellation notices for " << course_count << " courses: per course " << per_course.count() * 1000 << " ms";
+    for (std::size_t threads : {std::size_t(1), CancellationNotifier::defaultThreadCount()})
+    {
+        start = std::chrono::steady_clock::now();
+        const std::size_t students = CancellationNotifier(courses, threads).render(out);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        out.clear();
+        std::cout << ", deduplicated (" << students << " students) on " << threads << " threads " << elapsed.count() * 1000 << " ms";
+    }
+    std::cout << "\n";
+}
+
+// Benchmark: cost of recording a counter event and a timed section
+void benchmarkMetrics(std::size_t count)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Metrics::count(MetricCounter::MENU_INVALID);
+    }
+    const std::chrono::duration<double, std::nano> counting = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        ScopedMetricTimer timer(MetricTimer::MENU_END);
+    }
+    const std::chrono::duration<double, std::nano> timing = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Metrics: " << counting.count() / count << " ns per counter event, "
+              << timing.count() / count << " ns per timed section\n";
+}
+
+// Run the registration benchmarks (started with the --bench argument)
+void runBenchmarks()
+{
+    benchmarkEmailIndex(10000);
+    benchmarkEmailIndex(100000);
+    benchmarkImport(100000);
+    benchmarkImport(1000000);
+    benchmarkRosterDump(100000);
+    benchmarkRosterLayout(100000);
+    benchmarkLargeCourse(2000, 200);
+    benchmarkDispatch(1000000);
+    benchmarkStoreRestore(1000000, 10000);
+    benchmarkCommandProtocol(1000000);
+    runLoadBenchmark(WorkloadConfig());
+    benchmarkMetrics(10000000);
+    benchmarkWaitlist(200, 100000);
+    benchmarkCancellationNotices(500000);
+}
 
 // Main function: Entry point of the program
-int main()
+int main(int argc, char* argv[])
 {
     using namespace std;
 
+    // Benchmark mode instead of the interactive menu
+    if (argc > 1 && string(argv[1]) == "--bench")
+    {
+        runBenchmarks();
+        return 0;
+    }
+
+    // Self tests
+    if (argc > 1 && string(argv[1]) == "--selftest")
+    {
+        return runSelfTests() ? 0 : 1;
+    }
+
+    // Stress test of the concurrent registration path
+    if (argc > 1 && string(argv[1]) == "--stress")
+    {
+        const bool ok = stressConcurrentRegistrar(16) && stressConcurrentRegistrar(32);
+        return ok ? 0 : 1;
+    }
+
+    // Print a snapshot written by --store without loading it
+    if (argc > 2 && string(argv[1]) == "--report")
+    {
+        ReportWriter out;
+        const bool ok = printSnapshotReport(argv[2], out);
+        out.flushTo(cout);
+        return ok ? 0 : 1;
+    }
+
+    // Synthetic registration workload: "--load [requests] [courses] [zipf exponent] [seed]"
+    if (argc > 1 && string(argv[1]) == "--load")
+    {
+        WorkloadConfig config;
+        if (argc > 2) config.requests = strtoul(argv[2], nullptr, 10);
+        if (argc > 3) config.courses = max<size_t>(1, strtoul(argv[3], nullptr, 10));
+        if (argc > 4) config.zipf_exponent = strtod(argv[4], nullptr);
+        if (argc > 5) config.seed = static_cast<uint32_t>(strtoul(argv[5], nullptr, 10));
+        runLoadBenchmark(config);
+        return 0;
+    }
+
     // Initialize sample lecturers with their details
     Lecturer lecturer1("Elon", "Musk", "elon.musk@tesla.com", PROF);
     Lecturer lecturer2("Steve", "Jobs", "steve.jobs@apple.com", DR);
     Lecturer lecturer3("Bill", "Gates", "bill.gates@microsoft.com", PROF);
 
-    // Create a list of courses, each associated with a lecturer
-    vector<Course> courses = 
+    // Create a list of courses, each associated with a lecturer (moved in, not copied)
+    vector<Course> course_list;
+    course_list.reserve(3);
+    course_list.emplace_back("Programming", std::move(lecturer1));
+    course_list.emplace_back("Databases", std::move(lecturer2));
+    course_list.emplace_back("Software Engineering", std::move(lecturer3));
+    CourseCatalog courses(std::move(course_list));
+
+    // Registry of all registered students and the number of courses they hold
+    StudentRegistry registry;
+
+    // With "--store <path>" enrollments survive restarts: restore them, then log every change
+    // Status messages of the start-up steps go to stderr so they do not mix with --commands output
+    unique_ptr<EnrollmentStore> store;
+    for (int i = 1; i + 1 < argc; ++i)
     {
-        Course("Programming", lecturer1),
-        Course("Databases", lecturer2),
-        Course("Software Engineering", lecturer3)
-    };
+        if (string(argv[i]) == "--store")
+        {
+            store = make_unique<EnrollmentStore>(argv[i + 1]);
+            const EnrollmentStore::RestoreStats stats = store->restore(courses, registry);
+            clog << "Restored " << stats.snapshot_participants << " enrollments from the snapshot and "
+                 << stats.replayed_events << " from the log" << endl;
+        }
+    }
+
+    // Bulk-load enrollments given as "--import <file>" before starting the menu
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (string(argv[i]) == "--import")
+        {
+            EnrollmentImporter importer(courses, registry);
+            ImportReport report = importer.importFile(argv[i + 1]);
+            if (!report.file_opened)
+            {
+                clog << "Could not open enrollment file " << argv[i + 1] << endl;
+            }
+            report.print(clog);
+            if (store && report.added > 0)
+            {
+                store->writeSnapshot(courses); // Cheaper than logging every imported row
+            }
+        }
+    }
+
+    // Non-interactive use: "--commands" reads the command protocol from stdin,
+    // "--serve <socket>" from clients of a Unix domain socket
+    for (int i = 1; i < argc; ++i)
+    {
+        if (string(argv[i]) == "--commands")
+        {
+            CommandProcessor processor(courses, registry, store.get());
+            return processor.serve(0, 1) ? 0 : 1;
+        }
+        if (string(argv[i]) == "--serve" && i + 1 < argc)
+        {
+#ifdef _WIN32
+            cout << "--serve needs Unix domain sockets; use --commands" << endl;
+            return 1;
+#else
+            CommandProcessor processor(courses, registry, store.get());
+            return serveUnixSocket(argv[i + 1], processor) ? 0 : 1;
+#endif
+        }
+    }
 
-    // List to keep track of all registered students
-    vector<Student> students;
+    // Reports are rendered into this buffer and written with one call per menu action
+    ReportWriter report;
 
     // Menu-driven loop to interact with the program
     while (true) 
@@ -236,29 +4881,19 @@ int main()
              << "\n2. Display course details\n" 
              << "\n3. Display courses with available seats\n" 
              << "\n4. End program\n" 
+             << "\n5. Display metrics\n" 
+             << "\n6. Drop a course\n" 
              << "\nEnter your choice: ";
         int choice;
         cin >> choice; // Get user choice
 
         if (choice == 1) {
             // Handle course registration
-            string first_name, surname, email, university;
-            int matriculation_number, course_index;
+            REGISTRAR_COUNT(MetricCounter::MENU_REGISTER);
+            int course_index;
 
             // Gather student details
-            cout << "\nEnter student's first name: ";
-            cin >> first_name;
-            cout << "\nEnter student's surname: ";
-            cin >> surname;
-            cout << "\nEnter student's email: ";
-            cin >> email;
-            cout << "\nEnter student's university: ";
-            cin >> university;
-            cout << "\nEnter student's matriculation number: ";
-            cin >> matriculation_number;
-
-            // Create a new student object
-            Student new_student(surname, first_name, email, matriculation_number, university);
+            Student new_student = readStudent(cin, cout);
 
             // Display available courses
             cout << "\nAvailable courses:\n";
@@ -282,58 +4917,127 @@ int main()
             Course& selected_course = courses[course_index - 1];
 
             // Check if the student is allowed to register
-            if (university != "Our University" && new_student.getUniversity() != university) 
+            if (!registry.mayEnroll(new_student)) 
             {
                 cout << "\nStudents from other universities may only take one course." << endl;
                 continue;
             }
 
-            // Add the student to the selected course
-            if (selected_course.addParticipant(new_student)) 
+            // Add the student to the selected course, or to its waitlist if it is full
+            const size_t waitlist_size = selected_course.getWaitlistSize();
+            if (selected_course.addParticipant(std::move(new_student))) 
+            {
+                registry.recordEnrollment(selected_course.getParticipants().back()); // Count the course for this student
+                if (store && !store->logRegistration(course_index - 1, selected_course.getParticipants().back()))
+                {
+                    cout << "\nThe registration could not be saved and will be lost when the program ends." << endl;
+                }
+                else
+                {
+                    cout << "\nRegistration successful!" << endl;
+                }
+            }
+            else if (store && selected_course.getWaitlistSize() > waitlist_size
+                     && !store->logWaitlisted(course_index - 1, selected_course.getLastWaitlisted()))
+            {
+                cout << "\nThe waitlist place could not be saved and will be lost when the program ends." << endl;
+            }
+            if (store && store->snapshotDue())
             {
-                students.push_back(new_student); // Add to the global student list
-                cout << "\nRegistration successful!" << endl;
+                store->writeSnapshot(courses);
             }
         } 
         else if (choice == 2) 
         {
             // Display details of all courses and their participants
+            REGISTRAR_COUNT(MetricCounter::MENU_COURSE_DETAILS);
+            REGISTRAR_TIME(MetricTimer::MENU_COURSE_DETAILS);
             for (const auto& course : courses) 
             {
-                course.displayParticipants();
+                course.renderParticipants(report);
             }
+            report.flushTo(cout);
         } 
         else if (choice == 3) 
         {
             // Display courses with available seats
-            for (const auto& course : courses) 
+            REGISTRAR_COUNT(MetricCounter::MENU_AVAILABLE_SEATS);
+            REGISTRAR_TIME(MetricTimer::MENU_AVAILABLE_SEATS);
+            for (size_t index : courses.coursesWithAvailableSeats()) 
             {
-                if (!course.isFullyBooked()) 
-                {
-                    course.displayAvailableSeats();
-                }
+                courses[index].renderAvailableSeats(report);
             }
+            report.flushTo(cout);
         } 
         else if (choice == 4) 
         {
             // Notify participants of courses that will not take place
-            cout << "\nNotifying participants of courses that will not take place:\n";
-            for (const auto& course : courses) 
+            REGISTRAR_COUNT(MetricCounter::MENU_END);
+            REGISTRAR_TIME(MetricTimer::MENU_END);
+            report << "\nNotifying participants of courses that will not take place:\n";
+            CancellationNotifier(courses).render(report); // One notice per student, listing all their cancelled courses
+            report << "\nProgram ended.\n";
+            report.flushTo(cout);
+            if (store && !store->writeSnapshot(courses))
             {
-                if (course.hasFewParticipants()) 
-                {
-                    for (const auto& participant : course.getParticipants()) 
-                    {
-                        participant.display();
-                    }
-                }
+                cout << "\nThe enrollments could not be saved; changes after the last successful save are lost." << endl;
             }
-            cout << "\nProgram ended." << endl;
             break; // Exit the loop and end the program
         } 
+        else if (choice == 5) 
+        {
+            // Display the registration and display metrics
+            REGISTRAR_COUNT(MetricCounter::MENU_METRICS);
+            report << '\n';
+            Metrics::writeText(report);
+            report.flushTo(cout);
+        } 
+        else if (choice == 6) 
+        {
+            // Drop a course (or leave its waitlist); the first waiting student takes the seat
+            REGISTRAR_COUNT(MetricCounter::MENU_DROP);
+            string email;
+            size_t course_index;
+            cout << "\nEnter student's email: ";
+            cin >> email;
+            cout << "\nCourses:\n";
+            for (size_t i = 0; i < courses.size(); ++i) 
+            {
+                cout << i + 1 << ". " << courses[i].getName() << endl;
+            }
+            cout << "\nSelect a course: ";
+            cin >> course_index;
+            if (course_index < 1 || course_index > courses.size()) 
+            {
+                cout << "\nInvalid course selection!" << endl;
+                continue;
+            }
+
+            const DropResult result = dropEnrollment(courses[course_index - 1], registry, email);
+            if (!result.dropped)
+            {
+                cout << "\nNo registration with this email in the course." << endl;
+                continue;
+            }
+            const bool saved = !store || store->logDrop(course_index - 1, email);
+            if (store && saved && store->snapshotDue())
+            {
+                store->writeSnapshot(courses);
+            }
+            cout << "\n" << (result.was_participant ? "Course dropped." : "Removed from the waitlist.") << endl;
+            if (!saved)
+            {
+                cout << "The drop could not be saved and will be undone when the program restarts." << endl;
+            }
+            if (result.promoted != nullptr)
+            {
+                cout << "The Student with email: " << result.promoted->getEmail() << " moved up from the waitlist." << endl;
+            }
+        } 
         else 
         {
             // Handle invalid menu choices
+            REGISTRAR_COUNT(MetricCounter::MENU_INVALID);
             cout << "\nInvalid choice! Please try again." << endl;
         }
     }
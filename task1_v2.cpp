@@ -4,12 +4,63 @@
 #include <utility> // for std::move
 #include <algorithm> // for std::find_if
 #include <vector>
+#include <cstdint>
+#include <cctype>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
+#include <memory_resource>
+#include <chrono>
+
+// Table that maps strings to small dense IDs, so values repeated across many records
+// (university names) are stored once and compared as integers
+class StringInterner {
+public:
+    // ID of `text`, adding it to the table if it is new
+    std::uint32_t intern(std::string_view text) {
+        auto it = ids_.find(text);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+        const auto id = static_cast<std::uint32_t>(names_.size());
+        names_.emplace_back(text);
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+
+    // String for an ID returned by intern()
+    const std::string& name(std::uint32_t id) const noexcept { return names_[id]; }
+
+    std::size_t size() const noexcept { return names_.size(); }
+
+private:
+    std::deque<std::string> names_;                           // Interned strings by ID (stable addresses)
+    std::unordered_map<std::string_view, std::uint32_t> ids_; // Views into names_ -> ID
+};
+
+// Interning table for university names
+StringInterner& universityNames() {
+    static StringInterner table;
+    return table;
+}
+
+// Name of our own university and its interned ID
+const std::string HOME_UNIVERSITY = "Our University";
+
+std::uint32_t homeUniversityId() {
+    static const std::uint32_t id = universityNames().intern(HOME_UNIVERSITY);
+    return id;
+}
 
 class Person {
 public:
-    // Constructor with member initializer list and move semantics
-    Person(std::string surname, std::string first_name, std::string email)
-        : surname_(std::move(surname)), first_name_(std::move(first_name)), email_(std::move(email)) {}
+    // Allocator for the strings of a Person; objects created by a CourseRegistry get the
+    // registry's memory resource through uses-allocator construction
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    // Constructor copying the names into memory from the given allocator
+    Person(std::string_view surname, std::string_view first_name, std::string_view email, const allocator_type& alloc = {})
+        : surname_(surname, alloc), first_name_(first_name, alloc), email_(email, alloc) {}
 
     // Deleted default constructor to ensure explicit initialization
     Person() = delete;
@@ -26,9 +77,9 @@ public:
     Person& operator=(Person&&) noexcept = default;
 
     // Getter methods with `noexcept` for better performance guarantees
-    const std::string& getSurname() const noexcept { return surname_; }
-    const std::string& getFirstname() const noexcept { return first_name_; }
-    const std::string& getEmail() const noexcept { return email_; }
+    const std::pmr::string& getSurname() const noexcept { return surname_; }
+    const std::pmr::string& getFirstname() const noexcept { return first_name_; }
+    const std::pmr::string& getEmail() const noexcept { return email_; }
 
     // Virtual method to display the Person's information
     virtual void display() const {
@@ -37,10 +88,10 @@ public:
     }
 
 protected:
-    // Use `std::string` directly as members, taking advantage of its move semantics
-    std::string surname_;
-    std::string first_name_;
-    std::string email_;
+    // `std::pmr::string` members, allocated from the resource of the owning registry
+    std::pmr::string surname_;
+    std::pmr::string first_name_;
+    std::pmr::string email_;
 };
 
 // Enumeration for academic titles
@@ -54,9 +105,10 @@ enum class Title {
 // Derived class for Lecturer, inheriting from Person
 class Lecturer : public Person {
 public:
-    // Constructor with member initializer list and move semantics
-    Lecturer(std::string surname, std::string first_name, std::string email, Title academic_title)
-        : Person(std::move(surname), std::move(first_name), std::move(email)),
+    // Constructor with member initializer list, strings allocated from `alloc`
+    Lecturer(std::string_view surname, std::string_view first_name, std::string_view email, Title academic_title,
+             const allocator_type& alloc = {})
+        : Person(surname, first_name, email, alloc),
           academic_title_(academic_title) {}
 
     // Deleted default constructor for explicit initialization
@@ -81,8 +133,8 @@ public:
     }
 
 private:
-    // Helper function to convert Title enum to string for display
-    static std::string getTitleString(Title title) {
+    // Helper function to convert Title enum to string for display (static strings, no allocation)
+    static const char* getTitleString(Title title) noexcept {
         switch (title) {
         case Title::DR: return "Dr.";
         case Title::ASSIST_PROF: return "Assistant Professor";
@@ -98,10 +150,11 @@ private:
 // Derived class for Student, inheriting from Person
 class Student : public Person {
 public:
-    // Constructor with member initializer list and move semantics
-    Student(std::string surname, std::string first_name, std::string email, int matriculation_number, std::string university)
-        : Person(std::move(surname), std::move(first_name), std::move(email)),
-          matriculation_number_(matriculation_number), university_(std::move(university)) {}
+    // Constructor with member initializer list, strings allocated from `alloc`
+    Student(std::string_view surname, std::string_view first_name, std::string_view email, int matriculation_number,
+            std::string_view university, const allocator_type& alloc = {})
+        : Person(surname, first_name, email, alloc),
+          matriculation_number_(matriculation_number), university_id_(universityNames().intern(university)) {}
 
     // Deleted default constructor for explicit initialization
     Student() = delete;
@@ -115,7 +168,17 @@ public:
 
     // Getter for university name (const and noexcept for efficiency)
     const std::string& getUniversity() const noexcept {
-        return university_;
+        return universityNames().name(university_id_);
+    }
+
+    // Getter for the interned university ID
+    std::uint32_t getUniversityId() const noexcept {
+        return university_id_;
+    }
+
+    // Check if the student belongs to our own university (an integer compare)
+    bool isFromHomeUniversity() const {
+        return university_id_ == homeUniversityId();
     }
 
     // Getter for matriculation number (noexcept for performance)
@@ -132,14 +195,102 @@ public:
 
 private:
     int matriculation_number_; // Student's matriculation number
-    std::string university_;   // Name of the university the student is enrolled in
+    std::uint32_t university_id_; // Interned name of the university the student is enrolled in
+};
+
+// Open-addressing hash index over e-mail addresses (case-insensitive).
+// Slots hold only the hash and the roster position, so lookups never allocate.
+class EmailIndex {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    explicit EmailIndex(const allocator_type& alloc = {}) : slots_(alloc) {}
+
+    // FNV-1a hash of the lower-cased e-mail
+    static std::uint64_t hash(std::string_view email) noexcept {
+        std::uint64_t h = 14695981039346656037ULL;
+        for (unsigned char c : email) {
+            h ^= static_cast<unsigned char>(std::tolower(c));
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    // Case-insensitive e-mail comparison
+    static bool sameEmail(std::string_view a, std::string_view b) noexcept {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Roster position of `email`, or -1; `emailAt(position)` returns the e-mail stored there
+    template <typename EmailAt>
+    int find(std::string_view email, EmailAt emailAt) const {
+        if (slots_.empty()) {
+            return -1;
+        }
+        const std::uint64_t h = hash(email);
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = h & mask; slots_[i].position >= 0; i = (i + 1) & mask) {
+            if (slots_[i].hash == h && sameEmail(emailAt(slots_[i].position), email)) {
+                return slots_[i].position;
+            }
+        }
+        return -1;
+    }
+
+    // Index `email` at roster position `position` (must not be indexed yet)
+    void insert(std::string_view email, int position) {
+        if ((size_ + 1) * 2 > slots_.size()) {
+            rehash(slots_.empty() ? 16 : slots_.size() * 2);
+        }
+        place(hash(email), position);
+        ++size_;
+    }
+
+private:
+    struct Slot {
+        std::uint64_t hash = 0;
+        int position = -1; // -1 marks an empty slot
+    };
+
+    void place(std::uint64_t h, int position) {
+        const std::size_t mask = slots_.size() - 1;
+        std::size_t i = h & mask;
+        while (slots_[i].position >= 0) {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = Slot{h, position};
+    }
+
+    void rehash(std::size_t capacity) {
+        std::pmr::vector<Slot> old(capacity, slots_.get_allocator());
+        old.swap(slots_);
+        for (const auto& slot : old) {
+            if (slot.position >= 0) {
+                place(slot.hash, slot.position);
+            }
+        }
+    }
+
+    std::pmr::vector<Slot> slots_; // Power-of-two sized slot table, linear probing
+    std::size_t size_ = 0;
 };
 
 class Course {
 public:
-    // Constructor with member initializer list and move semantics
-    Course(std::string name, std::shared_ptr<Lecturer> lecturer)
-        : name_(std::move(name)), lecturer_(std::move(lecturer)) {}
+    // Allocator for the course name and roster containers
+    using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
+
+    // Constructor with member initializer list; the lecturer is owned by the CourseRegistry
+    Course(std::string_view name, const Lecturer& lecturer, const allocator_type& alloc = {})
+        : name_(name, alloc), lecturer_(&lecturer), participants_(alloc), email_index_(alloc) {}
 
     // Deleted default constructor for explicit initialization
     Course() = delete;
@@ -156,37 +307,37 @@ public:
     static constexpr int MIN_PARTICIPANTS = 3;
 
     // Getter for course name (const and noexcept for efficiency)
-    const std::string& getName() const noexcept { return name_; }
+    const std::pmr::string& getName() const noexcept { return name_; }
 
     // Getter for Lecturer object (returns by const reference for efficiency)
     const Lecturer& getLecturer() const noexcept { return *lecturer_; }
 
-    // Getter for the list of participants
-    const std::vector<std::unique_ptr<Student>>& getParticipants() const noexcept { return participants_; }
+    // Getter for the list of participants (the students are owned by the CourseRegistry)
+    const std::pmr::vector<Student*>& getParticipants() const noexcept { return participants_; }
 
     // Check if the course is fully booked
     bool isFullyBooked() const noexcept { return participants_.size() >= MAX_PARTICIPANTS; }
 
-    // Add a participant to the course
-    bool addParticipant(std::unique_ptr<Student> student) {
+    // Add a participant to the course, reporting the outcome to `out`
+    bool addParticipant(Student* student, std::ostream& out = std::cout) {
         if (isFullyBooked()) {
-            std::cout << "Course is already fully booked." << std::endl;
+            out << "Course is already fully booked." << std::endl;
             return false;
         }
 
-        // Check for duplicate email using `std::find_if`
-        auto it = std::find_if(participants_.begin(), participants_.end(), 
-                               [&student](const std::unique_ptr<Student>& participant) {
-                                   return participant->getEmail() == student->getEmail();
-                               });
+        // Check for duplicate email through the hash index
+        const int existing = email_index_.find(student->getEmail(), [this](int position) -> const std::pmr::string& {
+            return participants_[position]->getEmail();
+        });
 
-        if (it != participants_.end()) {
-            std::cout << "Student with email " << student->getEmail() << " is already registered." << std::endl;
+        if (existing >= 0) {
+            out << "Student with email " << student->getEmail() << " is already registered." << std::endl;
             return false;
         }
 
-        participants_.push_back(std::move(student));
-        std::cout << "Student was successfully added!" << std::endl;
+        email_index_.insert(student->getEmail(), static_cast<int>(participants_.size()));
+        participants_.push_back(student);
+        out << "Student was successfully added!" << std::endl;
         return true;
     }
 
@@ -217,26 +368,185 @@ public:
     bool hasFewParticipants() const noexcept { return participants_.size() < MIN_PARTICIPANTS; }
 
 private:
-    std::string name_;                            // Name of the course
-    std::shared_ptr<Lecturer> lecturer_;          // Shared pointer to Lecturer for shared ownership
-    std::vector<std::unique_ptr<Student>> participants_; // Vector of unique pointers to students
+    std::pmr::string name_;                       // Name of the course
+    const Lecturer* lecturer_;                    // Lecturer, owned by the CourseRegistry
+    std::pmr::vector<Student*> participants_;     // Students, owned by the CourseRegistry
+    EmailIndex email_index_;                      // Hash index over the participants' emails
 };
 
-int main() {
-    using namespace std;
+// Memory resource that forwards to another resource and counts what it hands out
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+        : upstream_(upstream) {}
+
+    std::size_t allocations() const noexcept { return allocations_; }
+    std::size_t bytes() const noexcept { return bytes_; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations_;
+        bytes_ += bytes;
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        upstream_->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::size_t allocations_ = 0;
+    std::size_t bytes_ = 0;
+};
+
+// Owner of the lecturers, students and courses of a semester.
+// Every object - and every string and roster inside it - is allocated from one memory
+// resource. With the default resource each object is an ordinary heap allocation;
+// with a std::pmr::monotonic_buffer_resource the whole semester is bump-allocated
+// and handed back in one shot when the arena is released.
+class CourseRegistry {
+public:
+    explicit CourseRegistry(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : resource_(resource), owned_(resource), courses_(resource) {}
+
+    // Destroys all objects in reverse creation order
+    ~CourseRegistry() {
+        for (auto it = owned_.rbegin(); it != owned_.rend(); ++it) {
+            it->destroy(it->object, resource_);
+        }
+    }
+
+    CourseRegistry(const CourseRegistry&) = delete;
+    CourseRegistry& operator=(const CourseRegistry&) = delete;
+
+    // Create an object owned by the registry; allocator-aware types receive the
+    // registry's resource as their trailing allocator argument
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        std::pmr::polymorphic_allocator<T> alloc(resource_);
+        T* object = alloc.allocate(1);
+        try {
+            alloc.construct(object, std::forward<Args>(args)...);
+        } catch (...) {
+            alloc.deallocate(object, 1);
+            throw;
+        }
+        owned_.push_back({object, &destroyObject<T>});
+        return object;
+    }
+
+    // Destroy the most recently created object early (e.g. a rejected registration);
+    // objects created earlier live until the registry is destroyed
+    template <typename T>
+    void discard(T* object) {
+        if (!owned_.empty() && owned_.back().object == object) {
+            owned_.back().destroy(object, resource_);
+            owned_.pop_back();
+        }
+    }
+
+    // Create a course and add it to the course list
+    Course& addCourse(std::string_view name, const Lecturer& lecturer) {
+        Course* course = create<Course>(name, lecturer);
+        courses_.push_back(course);
+        return *course;
+    }
 
-    // Initialize sample lecturers using shared pointers
-    auto lecturer1 = make_shared<Lecturer>("Elon", "Musk", "elon.musk@tesla.com", 'PROF');
-    auto lecturer2 = make_shared<Lecturer>("Steve", "Jobs", "steve.jobs@apple.com", 'DR');
-    auto lecturer3 = make_shared<Lecturer>("Bill", "Gates", "bill.gates@microsoft.com", 'PROF');
+    const std::pmr::vector<Course*>& getCourses() const noexcept { return courses_; }
 
-    // Create courses, each associated with a shared lecturer
-    vector<Course> courses = {
-        Course("Programming", lecturer1),
-        Course("Databases", lecturer2),
-        Course("Software Engineering", lecturer3)
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+private:
+    struct Owned {
+        void* object;
+        void (*destroy)(void*, std::pmr::memory_resource*);
+    };
+
+    template <typename T>
+    static void destroyObject(void* object, std::pmr::memory_resource* resource) {
+        std::pmr::polymorphic_allocator<T> alloc(resource);
+        static_cast<T*>(object)->~T();
+        alloc.deallocate(static_cast<T*>(object), 1);
+    }
+
+    std::pmr::memory_resource* resource_; // Resource all objects are allocated from
+    std::pmr::vector<Owned> owned_;       // Every created object, in creation order
+    std::pmr::vector<Course*> courses_;   // Courses in menu order
+};
+
+// Stream buffer that discards everything written to it
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// Benchmark: build and tear down a semester of `student_count` students, once with
+// one heap allocation per object and string, once in a monotonic arena
+void benchmarkArena(std::size_t student_count) {
+    NullBuffer discard;
+    std::ostream silent(&discard); // Receives the per-registration messages
+    auto runSemester = [student_count, &silent](std::pmr::memory_resource* resource) {
+        CourseRegistry registry(resource);
+        const Lecturer* lecturer = registry.create<Lecturer>("Lovelace", "Ada", "ada.lovelace@uni.org", Title::PROF);
+        Course* course = nullptr;
+        for (std::size_t i = 0; i < student_count; ++i) {
+            if (i % Course::MAX_PARTICIPANTS == 0) {
+                course = &registry.addCourse("Course number " + std::to_string(i / Course::MAX_PARTICIPANTS), *lecturer);
+            }
+            const std::string email = "student.with.a.long.address" + std::to_string(i) + "@university.org";
+            course->addParticipant(registry.create<Student>("Surname", "First", email, static_cast<int>(i), HOME_UNIVERSITY),
+                                   silent);
+        }
     };
 
+    CountingResource heap;
+    auto start = std::chrono::steady_clock::now();
+    runSemester(&heap);
+    std::chrono::duration<double> heap_time = std::chrono::steady_clock::now() - start;
+
+    CountingResource upstream;
+    start = std::chrono::steady_clock::now();
+    {
+        std::pmr::monotonic_buffer_resource arena(1 << 20, &upstream);
+        runSemester(&arena);
+    }
+    std::chrono::duration<double> arena_time = std::chrono::steady_clock::now() - start;
+
+    std::cout << student_count << " students: heap " << heap.allocations() << " allocations, "
+              << heap_time.count() * 1000 << " ms; arena " << upstream.allocations() << " allocations, "
+              << arena_time.count() * 1000 << " ms\n";
+}
+
+int main(int argc, char* argv[]) {
+    using namespace std;
+
+    // Benchmark mode instead of the interactive menu
+    if (argc > 1 && string_view(argv[1]) == "--bench") {
+        benchmarkArena(100000);
+        benchmarkArena(1000000);
+        return 0;
+    }
+
+    // All objects of the semester live in one arena, released when main returns
+    pmr::monotonic_buffer_resource arena;
+    CourseRegistry registry(&arena);
+
+    // Initialize sample lecturers in the registry
+    const Lecturer* lecturer1 = registry.create<Lecturer>("Elon", "Musk", "elon.musk@tesla.com", Title::PROF);
+    const Lecturer* lecturer2 = registry.create<Lecturer>("Steve", "Jobs", "steve.jobs@apple.com", Title::DR);
+    const Lecturer* lecturer3 = registry.create<Lecturer>("Bill", "Gates", "bill.gates@microsoft.com", Title::PROF);
+
+    // Create courses, each associated with a lecturer
+    registry.addCourse("Programming", *lecturer1);
+    registry.addCourse("Databases", *lecturer2);
+    registry.addCourse("Software Engineering", *lecturer3);
+    const auto& courses = registry.getCourses();
+
     while (true) {
         cout << "\nMenu:\n"
              << "1. Register for a course\n"
@@ -263,11 +573,9 @@ int main() {
             cout << "Enter student's matriculation number: ";
             cin >> matriculation_number;
 
-            auto new_student = make_unique<Student>(surname, first_name, email, matriculation_number, university);
-
             cout << "Available courses:\n";
             for (size_t i = 0; i < courses.size(); ++i) {
-                cout << i + 1 << ". " << courses[i].getName() << endl;
+                cout << i + 1 << ". " << courses[i]->getName() << endl;
             }
 
             cout << "Select a course: ";
@@ -278,27 +586,31 @@ int main() {
                 continue;
             }
 
-            Course& selected_course = courses[course_index - 1];
+            Course& selected_course = *courses[course_index - 1];
 
-            if (selected_course.addParticipant(std::move(new_student))) {
+            // The student is allocated in the arena; a rejected one is discarded right away
+            auto new_student = registry.create<Student>(surname, first_name, email, matriculation_number, university);
+            if (selected_course.addParticipant(new_student)) {
                 cout << "Registration successful!\n";
+            } else {
+                registry.discard(new_student);
             }
 
         } else if (choice == 2) {
-            for (const auto& course : courses) {
-                course.displayParticipants();
+            for (const auto* course : courses) {
+                course->displayParticipants();
             }
         } else if (choice == 3) {
-            for (const auto& course : courses) {
-                if (!course.isFullyBooked()) {
-                    course.displayAvailableSeats();
+            for (const auto* course : courses) {
+                if (!course->isFullyBooked()) {
+                    course->displayAvailableSeats();
                 }
             }
         } else if (choice == 4) {
             cout << "\nNotifying participants of courses that will not take place:\n";
-            for (const auto& course : courses) {
-                if (course.hasFewParticipants()) {
-                    for (const auto& participant : course.getParticipants()) {
+            for (const auto* course : courses) {
+                if (course->hasFewParticipants()) {
+                    for (const auto* participant : course->getParticipants()) {
                         participant->display();
                     }
                 }
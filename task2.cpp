@@ -5,6 +5,18 @@
 #include <memory>
 #include <map>
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 using namespace std;
 
 // Class to manage individual Player data
@@ -25,6 +37,11 @@ public:
     Player() : number(0), height(0), weight(0), points(0), yearOfBirth(0),
                fightsParticipated(0), wins(0), ties(0), losses(0) {}
 
+    // Constructor for players that are not entered interactively
+    Player(int number, string surname, string firstname, int height, float weight, int yearOfBirth)
+        : number(number), surname(move(surname)), firstname(move(firstname)), height(height), weight(weight),
+          points(0), yearOfBirth(yearOfBirth), fightsParticipated(0), wins(0), ties(0), losses(0) {}
+
     // Input stream operator to read player data
     friend istream& operator>>(istream& in, Player& player) {
         cout << "Enter Player Number (unique): ";
@@ -68,38 +85,1104 @@ public:
 
     // Getter functions to access player data
     int getNumber() const { return number; }
+    int getFightsParticipated() const { return fightsParticipated; }
+    int getWins() const { return wins; }
+    int getTies() const { return ties; }
+    int getLosses() const { return losses; }
     string getName() const { return firstname + " " + surname; }
     int getHeight() const { return height; }
     int getPoints() const { return points; }
     float getWeight() const { return weight; }
 };
 
+// Hash table from player number to the player's slot in the player table.
+// Open addressing with linear probing in a power-of-two table that is kept at most
+// half full, so a lookup touches one or two adjacent entries of one array.
+class PlayerIndex {
+private:
+    struct Entry {
+        int number = 0;  // Player number
+        int slot = -1;   // Slot in the player table, -1 marks an empty entry
+    };
+
+    vector<Entry> entries;  // The table
+    size_t count = 0;       // Occupied entries
+    int shift = 64;         // 64 - log2(table size), for the multiplicative hash
+
+    // Fibonacci hashing: the top bits of number * 2^64 / golden ratio
+    size_t home(int number) const {
+        return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(number)) * 0x9E3779B97F4A7C15ULL) >> shift);
+    }
+
+    void rehash(size_t capacity) {
+        vector<Entry> old(capacity);
+        old.swap(entries);
+        shift = 64;
+        for (size_t size = capacity; size > 1; size /= 2) {
+            --shift;
+        }
+        for (const Entry& entry : old) {
+            if (entry.slot >= 0) {
+                place(entry.number, entry.slot);
+            }
+        }
+    }
+
+    void place(int number, int slot) {
+        const size_t mask = entries.size() - 1;
+        size_t i = home(number);
+        while (entries[i].slot >= 0) {
+            i = (i + 1) & mask;
+        }
+        entries[i].number = number;
+        entries[i].slot = slot;
+    }
+
+public:
+    // Make room for `players` entries without rehashing
+    void reserve(size_t players) {
+        size_t capacity = 8;
+        while (capacity < players * 2) {
+            capacity *= 2;
+        }
+        if (capacity > entries.size()) {
+            rehash(capacity);
+        }
+    }
+
+    // Slot of the player with this number, or -1
+    int find(int number) const {
+        if (entries.empty()) {
+            return -1;
+        }
+        const size_t mask = entries.size() - 1;
+        for (size_t i = home(number); entries[i].slot >= 0; i = (i + 1) & mask) {
+            if (entries[i].number == number) {
+                return entries[i].slot;
+            }
+        }
+        return -1;
+    }
+
+    // Add a player number (which must not be indexed yet) at `slot`
+    void insert(int number, int slot) {
+        if ((count + 1) * 2 > entries.size()) {
+            rehash(entries.empty() ? 16 : entries.size() * 2);
+        }
+        place(number, slot);
+        ++count;
+    }
+
+    size_t size() const { return count; }
+};
+
+// Players ranked by points, kept up to date after every fight. Ranking rules: more
+// points first; among equal points, the lower player number first. The leader is
+// therefore the winner displayWinner reports.
+//
+// The ranking is stored as a list of sorted blocks of at most MAX_BLOCK keys, each
+// key packing (points, number) so that ascending keys are ranking order. A key is
+// located by binary search over the last key of every block, and a Fenwick tree over
+// the block sizes gives the number of players in the blocks before it. Moving a
+// player shifts at most one block; the leader is the first key, and the top k are
+// the first k keys.
+class Leaderboard {
+private:
+    static const size_t MAX_BLOCK = 512;  // Full blocks are split in half
+
+    vector<vector<uint64_t>> blocks;  // Consecutive runs of the ranking, none empty
+    vector<uint64_t> lastKeys;        // Last key of each block
+    vector<int> counts;               // Fenwick tree over block sizes (1-based)
+    size_t total = 0;                 // Ranked players
+
+    static uint64_t makeKey(int points, int number) {
+        return (static_cast<uint64_t>(0xFFFFFFFFu - static_cast<uint32_t>(points)) << 32)
+             | (static_cast<uint32_t>(number) ^ 0x80000000u);
+    }
+
+    static int numberOf(uint64_t key) {
+        return static_cast<int>(static_cast<uint32_t>(key) ^ 0x80000000u);
+    }
+
+    // Block that holds `key`, or where it belongs
+    size_t blockOf(uint64_t key) const {
+        const size_t block = lower_bound(lastKeys.begin(), lastKeys.end(), key) - lastKeys.begin();
+        return min(block, blocks.size() - 1);
+    }
+
+    void rebuildCounts() {
+        counts.assign(blocks.size() + 1, 0);
+        for (size_t i = 1; i <= blocks.size(); ++i) {
+            counts[i] += static_cast<int>(blocks[i - 1].size());
+            const size_t parent = i + (i & (0 - i));
+            if (parent <= blocks.size()) {
+                counts[parent] += counts[i];
+            }
+        }
+    }
+
+    void addCount(size_t block, int delta) {
+        for (size_t i = block + 1; i < counts.size(); i += i & (0 - i)) {
+            counts[i] += delta;
+        }
+    }
+
+    // Players in the blocks before `block`
+    size_t countBefore(size_t block) const {
+        size_t count = 0;
+        for (size_t i = block; i > 0; i -= i & (0 - i)) {
+            count += counts[i];
+        }
+        return count;
+    }
+
+public:
+    size_t size() const { return total; }
+
+    // Rank a new player
+    void insert(int points, int number) {
+        const uint64_t key = makeKey(points, number);
+        ++total;
+        if (blocks.empty()) {
+            blocks.push_back(vector<uint64_t>(1, key));
+            lastKeys.push_back(key);
+            rebuildCounts();
+            return;
+        }
+        const size_t b = blockOf(key);
+        vector<uint64_t>& block = blocks[b];
+        block.insert(lower_bound(block.begin(), block.end(), key), key);
+        lastKeys[b] = block.back();
+        if (block.size() <= MAX_BLOCK) {
+            addCount(b, 1);
+            return;
+        }
+        vector<uint64_t> upper;
+        upper.reserve(MAX_BLOCK + 1);
+        upper.assign(block.begin() + MAX_BLOCK / 2, block.end());
+        block.resize(MAX_BLOCK / 2);
+        lastKeys[b] = block.back();
+        lastKeys.insert(lastKeys.begin() + b + 1, upper.back());
+        blocks.insert(blocks.begin() + b + 1, move(upper));
+        rebuildCounts();
+    }
+
+    // Remove a ranked player
+    void erase(int points, int number) {
+        const uint64_t key = makeKey(points, number);
+        const size_t b = blockOf(key);
+        vector<uint64_t>& block = blocks[b];
+        block.erase(lower_bound(block.begin(), block.end(), key));
+        --total;
+        if (!block.empty()) {
+            lastKeys[b] = block.back();
+            addCount(b, -1);
+            return;
+        }
+        blocks.erase(blocks.begin() + b);
+        lastKeys.erase(lastKeys.begin() + b);
+        rebuildCounts();
+    }
+
+    // Re-rank a player whose points changed
+    void update(int number, int oldPoints, int newPoints) {
+        if (oldPoints != newPoints) {
+            erase(oldPoints, number);
+            insert(newPoints, number);
+        }
+    }
+
+    // Number of the leading player; there must be at least one player
+    int getLeader() const { return numberOf(blocks.front().front()); }
+
+    // Replace the ranking with these (points, number) pairs
+    void rebuild(const vector<pair<int, int>>& ranked) {
+        vector<uint64_t> keys;
+        keys.reserve(ranked.size());
+        for (const auto& entry : ranked) {
+            keys.push_back(makeKey(entry.first, entry.second));
+        }
+        sort(keys.begin(), keys.end());
+        blocks.clear();
+        lastKeys.clear();
+        for (size_t first = 0; first < keys.size(); first += MAX_BLOCK / 2) {
+            vector<uint64_t> block;
+            block.reserve(MAX_BLOCK + 1);
+            block.assign(keys.begin() + first, keys.begin() + min(keys.size(), first + MAX_BLOCK / 2));
+            lastKeys.push_back(block.back());
+            blocks.push_back(move(block));
+        }
+        total = keys.size();
+        rebuildCounts();
+    }
+
+    // 1-based rank of a ranked player
+    size_t rankOf(int points, int number) const {
+        const uint64_t key = makeKey(points, number);
+        const size_t b = blockOf(key);
+        const vector<uint64_t>& block = blocks[b];
+        return countBefore(b) + (lower_bound(block.begin(), block.end(), key) - block.begin()) + 1;
+    }
+
+    // Numbers of the first `count` players in ranking order
+    vector<int> top(size_t count) const {
+        vector<int> numbers;
+        numbers.reserve(min(count, total));
+        for (size_t b = 0; b < blocks.size() && numbers.size() < count; ++b) {
+            for (size_t i = 0; i < blocks[b].size() && numbers.size() < count; ++i) {
+                numbers.push_back(numberOf(blocks[b][i]));
+            }
+        }
+        return numbers;
+    }
+};
+
+// One side of a scheduled bout: a player, or the winner or loser of an earlier bout
+// of the same schedule. Neither (no player, no bout) stands for a bye.
+struct Entrant {
+    const Player* player = nullptr;
+    int bout = -1;       // Index of the deciding bout in the schedule
+    bool loser = false;  // The loser rather than the winner of that bout advances
+
+    bool isBye() const { return !player && bout < 0; }
+};
+
+// A bout of a generated schedule
+struct Bout {
+    enum Bracket { POOL, WINNERS, LOSERS, GRAND_FINAL };
+
+    Bracket bracket;
+    int group;  // Pool or bracket the bout belongs to
+    int round;  // 1-based round within its bracket
+    Entrant first;
+    Entrant second;
+};
+
+// Generates tournament schedules without pairing anyone by hand.
+//
+// Players are first split into weight classes in which every two players are
+// compatible (one is operator>= the other), so no bout of any round can pair
+// incompatible players, whoever wins the earlier rounds. Sorted by height, a weight
+// class is a run of non-decreasing weights; the fewest such classes are found in
+// O(n log n) by placing each player on the class whose last weight is the highest
+// that does not exceed the player's. That can leave a player alone in a class while
+// others could take them, so lone players are then moved into a class where they fit,
+// paired with a compatible end of a class that can spare one, or grouped with each
+// other. A player is left out only if no class can take them: they are compatible
+// with nobody, or only with a member of a two-player class.
+//
+// Each class is then split into as few near-equal pools or brackets as keep
+// everyone within the fight limit: at most limit + 1 players per round-robin pool,
+// 2^limit per single-elimination bracket and 2^(limit / 2) per double-elimination
+// bracket. A group is never a single player unless the limit allows only two
+// players per group and the class is odd. The limit counts the bouts of this
+// schedule only; fights players have already recorded are not taken into account.
+class TournamentScheduler {
+public:
+    enum Format { ROUND_ROBIN, SINGLE_ELIMINATION, DOUBLE_ELIMINATION };
+
+private:
+    struct Seeded {
+        const Player* player;
+        size_t seed;  // Position in the seeding order
+    };
+
+    vector<Seeded> players;
+    int maxFights;  // Bouts per player in one schedule, 0 for no limit
+    vector<Bout> bouts;
+    int groups = 0;
+
+    // Largest group in which nobody can fight more than maxFights bouts
+    size_t groupLimit(Format format) const {
+        const int depth = format == ROUND_ROBIN ? 0 : format == SINGLE_ELIMINATION ? maxFights : maxFights / 2;
+        if (maxFights <= 0 || depth >= 30) {
+            return players.size();
+        }
+        return format == ROUND_ROBIN ? static_cast<size_t>(maxFights) + 1 : size_t(1) << depth;
+    }
+
+    // Height order, then weight; within a weight class this is operator>= order
+    static bool shorter(const Seeded& a, const Seeded& b) {
+        return a.player->getHeight() < b.player->getHeight()
+            || (a.player->getHeight() == b.player->getHeight() && a.player->getWeight() < b.player->getWeight());
+    }
+
+    // Fewest classes of mutually compatible players, for players sorted by shorter()
+    static vector<vector<Seeded>> chains(const vector<Seeded>& byHeight) {
+        vector<vector<Seeded>> classes;
+        vector<pair<float, size_t>> lastWeights;  // (weight of the last player, class), heaviest first
+        for (const Seeded& entry : byHeight) {
+            auto fit = lower_bound(lastWeights.begin(), lastWeights.end(), entry.player->getWeight(),
+                                   [](const pair<float, size_t>& last, float weight) { return last.first > weight; });
+            if (fit == lastWeights.end()) {
+                lastWeights.emplace_back(entry.player->getWeight(), classes.size());
+                classes.emplace_back(1, entry);
+            } else {
+                fit->first = entry.player->getWeight();
+                classes[fit->second].push_back(entry);
+            }
+        }
+        return classes;
+    }
+
+    // Put a lone player into one of `classes` (all of two or more players), keeping
+    // every class mutually compatible; false if none can take them
+    static bool placeLonePlayer(vector<vector<Seeded>>& classes, const Seeded& lone) {
+        const Player& player = *lone.player;
+        for (vector<Seeded>& weightClass : classes) {
+            // Between two neighbours, both compatible with the player
+            auto next = lower_bound(weightClass.begin(), weightClass.end(), lone, shorter);
+            if ((next == weightClass.begin() || player >= *prev(next)->player)
+                && (next == weightClass.end() || *next->player >= player)) {
+                weightClass.insert(next, lone);
+                return true;
+            }
+        }
+        for (size_t i = 0; i < classes.size(); ++i) {
+            // With the lightest or heaviest player of a class that keeps two players
+            if (classes[i].size() < 3) {
+                continue;
+            }
+            const Seeded lightest = classes[i].front();
+            const Seeded heaviest = classes[i].back();
+            if (player >= *lightest.player) {
+                classes[i].erase(classes[i].begin());
+                classes.push_back({lightest, lone});
+                return true;
+            }
+            if (*heaviest.player >= player) {
+                classes[i].pop_back();
+                classes.push_back({lone, heaviest});
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Weight classes, each ordered by height
+    vector<vector<Seeded>> weightClasses() const {
+        vector<Seeded> byHeight = players;
+        sort(byHeight.begin(), byHeight.end(), shorter);
+        vector<vector<Seeded>> classes;
+        vector<Seeded> lonePlayers;
+        for (vector<Seeded>& weightClass : chains(byHeight)) {
+            if (weightClass.size() == 1) {
+                lonePlayers.push_back(weightClass.front());
+            } else {
+                classes.push_back(move(weightClass));
+            }
+        }
+        vector<Seeded> remaining;
+        for (const Seeded& lone : lonePlayers) {
+            if (!placeLonePlayer(classes, lone)) {
+                remaining.push_back(lone);
+            }
+        }
+        for (vector<Seeded>& weightClass : chains(remaining)) {  // Lone players compatible with each other
+            classes.push_back(move(weightClass));
+        }
+        return classes;
+    }
+
+    // Schedule a bout between two entrants and return the one who advances; a bye
+    // loses without a bout
+    Entrant play(Bout::Bracket bracket, int group, int round, const Entrant& first, const Entrant& second,
+                 Entrant* loser = nullptr) {
+        Entrant winner;
+        if (first.isBye() || second.isBye()) {
+            winner = first.isBye() ? second : first;
+            if (loser) {
+                *loser = Entrant();
+            }
+            return winner;
+        }
+        bouts.push_back({bracket, group, round, first, second});
+        winner.bout = static_cast<int>(bouts.size() - 1);
+        if (loser) {
+            *loser = winner;
+            loser->loser = true;
+        }
+        return winner;
+    }
+
+    // Pair neighbours off in one round
+    vector<Entrant> pairUp(Bout::Bracket bracket, int group, int round, const vector<Entrant>& entrants) {
+        if (entrants.size() < 2) {
+            return entrants;
+        }
+        vector<Entrant> advancing;
+        for (size_t i = 0; i + 1 < entrants.size(); i += 2) {
+            advancing.push_back(play(bracket, group, round, entrants[i], entrants[i + 1]));
+        }
+        return advancing;
+    }
+
+    // Everyone meets everyone once, by the circle method
+    void scheduleRoundRobin(const vector<Seeded>& pool, int group) {
+        vector<const Player*> circle;
+        for (const Seeded& entry : pool) {
+            circle.push_back(entry.player);
+        }
+        if (circle.size() % 2 == 1) {
+            circle.push_back(nullptr);  // Sits out the round
+        }
+        const size_t size = circle.size();
+        for (size_t round = 1; round < size; ++round) {
+            for (size_t i = 0; i < size / 2; ++i) {
+                Entrant first, second;
+                first.player = circle[i];
+                second.player = circle[size - 1 - i];
+                play(Bout::POOL, group, static_cast<int>(round), first, second);
+            }
+            rotate(circle.begin() + 1, circle.end() - 1, circle.end());
+        }
+    }
+
+    // A seeded knockout bracket, with a losers bracket and grand final for double elimination
+    void scheduleElimination(vector<Seeded> bracket, int group, bool doubleElimination) {
+        sort(bracket.begin(), bracket.end(), [](const Seeded& a, const Seeded& b) { return a.seed < b.seed; });
+
+        // Standard seed positions, so that the top seeds meet as late as possible and
+        // the byes of a bracket that is not full go to them
+        vector<size_t> positions(1, 0);
+        while (positions.size() < bracket.size()) {
+            vector<size_t> doubled;
+            for (size_t seed : positions) {
+                doubled.push_back(seed);
+                doubled.push_back(positions.size() * 2 - 1 - seed);
+            }
+            positions.swap(doubled);
+        }
+        vector<Entrant> current(positions.size());
+        for (size_t i = 0; i < positions.size(); ++i) {
+            if (positions[i] < bracket.size()) {
+                current[i].player = bracket[positions[i]].player;
+            }
+        }
+
+        vector<vector<Entrant>> losers;  // Losers of each winners-bracket round
+        for (int round = 1; current.size() > 1; ++round) {
+            vector<Entrant> advancing;
+            losers.emplace_back();
+            for (size_t i = 0; i + 1 < current.size(); i += 2) {
+                Entrant loser;
+                advancing.push_back(play(Bout::WINNERS, group, round, current[i], current[i + 1], &loser));
+                losers.back().push_back(loser);
+            }
+            current.swap(advancing);
+        }
+        if (!doubleElimination || losers.empty()) {
+            return;
+        }
+
+        // Losers bracket: the first-round losers play each other, then every later
+        // round's losers drop in against the survivors, who are then paired off again
+        int round = 1;
+        vector<Entrant> survivors = pairUp(Bout::LOSERS, group, round, losers[0]);
+        for (size_t r = 1; r < losers.size(); ++r) {
+            vector<Entrant> dropping = losers[r];
+            if (r % 2 == 1) {
+                reverse(dropping.begin(), dropping.end());  // Avoid immediate rematches
+            }
+            ++round;
+            for (size_t i = 0; i < survivors.size(); ++i) {
+                survivors[i] = play(Bout::LOSERS, group, round, survivors[i], dropping[i]);
+            }
+            if (survivors.size() > 1) {
+                survivors = pairUp(Bout::LOSERS, group, ++round, survivors);
+            }
+        }
+        play(Bout::GRAND_FINAL, group, 1, current[0], survivors[0]);
+    }
+
+public:
+    // `seeded` in seeding order (for example the leaderboard); maxFights 0 for no limit
+    TournamentScheduler(const vector<const Player*>& seeded, int maxFights) : maxFights(maxFights) {
+        players.reserve(seeded.size());
+        for (size_t i = 0; i < seeded.size(); ++i) {
+            players.push_back({seeded[i], i});
+        }
+    }
+
+    // Generate the bouts of a tournament in the given format. Later bouts refer to
+    // earlier ones through their entrants.
+    const vector<Bout>& schedule(Format format) {
+        bouts.clear();
+        groups = 0;
+        const size_t limit = groupLimit(format);
+        for (const vector<Seeded>& weightClass : weightClasses()) {
+            const size_t count = (weightClass.size() + limit - 1) / limit;  // Groups of near-equal size
+            for (size_t g = 0; g < count; ++g) {
+                const vector<Seeded> group(weightClass.begin() + weightClass.size() * g / count,
+                                           weightClass.begin() + weightClass.size() * (g + 1) / count);
+                if (group.size() < 2) {
+                    continue;
+                }
+                ++groups;
+                if (format == ROUND_ROBIN) {
+                    scheduleRoundRobin(group, groups);
+                } else {
+                    scheduleElimination(group, groups, format == DOUBLE_ELIMINATION);
+                }
+            }
+        }
+        return bouts;
+    }
+
+    // Pools or brackets in the last schedule
+    int getGroupCount() const { return groups; }
+};
+
+// First bytes of a binary fight log, which continues with records of three
+// little-endian 32-bit integers: player 1 number, player 2 number, result code
+const char FIGHT_LOG_MAGIC[4] = {'F', 'L', 'O', 'G'};
+
+// One fight to record in bulk (result 1: player 1 wins, 2: player 2 wins, 3: tie)
+struct FightRow {
+    int player1;
+    int player2;
+    int result;
+    size_t row;         // 1-based line (text) or record (binary) number
+    const char* error;  // Why the row could not be parsed, or nullptr
+};
+
+// Outcome of a bulk fight-result import
+struct IngestReport {
+    static const size_t MAX_LISTED = 20;  // Rejected rows listed individually
+
+    size_t applied = 0;                         // Fights recorded
+    size_t rejected = 0;                        // Rows that were not recorded
+    vector<pair<size_t, string>> rejectedRows;  // (row number, reason) of the first MAX_LISTED
+
+    void reject(size_t row, const char* reason) {
+        ++rejected;
+        if (rejectedRows.size() < MAX_LISTED) {
+            rejectedRows.emplace_back(row, reason);
+        }
+    }
+
+    // Add the outcome of the rows that follow this report's rows
+    void merge(const IngestReport& later) {
+        applied += later.applied;
+        rejected += later.rejected;
+        for (size_t i = 0; i < later.rejectedRows.size() && rejectedRows.size() < MAX_LISTED; ++i) {
+            rejectedRows.push_back(later.rejectedRows[i]);
+        }
+    }
+};
+
+// Worker threads that live as long as their owner, each with its own task queue, so
+// bulk imports do not start threads per chunk. Tasks posted to one worker run in
+// order on that worker. Player slots are sharded over the workers in stripes of
+// STRIPE slots (see shardOf): a task that writes players of one shard is posted to
+// that shard's worker, so no player is written by two threads. Any thread may post.
+class ShardWorkers {
+public:
+    explicit ShardWorkers(unsigned count) {
+        for (unsigned i = 0; i < count; ++i) {
+            queues.emplace_back(new Queue);
+        }
+        for (unsigned i = 0; i < count; ++i) {
+            threads.emplace_back(&ShardWorkers::run, this, ref(*queues[i]));
+        }
+    }
+
+    ~ShardWorkers() {
+        for (auto& queue : queues) {
+            {
+                lock_guard<mutex> lock(queue->lock);
+                queue->stopping = true;
+            }
+            queue->ready.notify_one();
+        }
+        for (thread& worker : threads) {
+            worker.join();
+        }
+    }
+
+    ShardWorkers(const ShardWorkers&) = delete;
+    ShardWorkers& operator=(const ShardWorkers&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(threads.size()); }
+
+    // Worker owning the player in `slot`
+    unsigned shardOf(int slot) const { return static_cast<unsigned>(slot / STRIPE) % size(); }
+
+    void post(unsigned worker, function<void()> task) {
+        {
+            lock_guard<mutex> lock(idleMutex);
+            ++pending;
+        }
+        Queue& queue = *queues[worker];
+        {
+            lock_guard<mutex> lock(queue.lock);
+            queue.tasks.push_back(move(task));
+        }
+        queue.ready.notify_one();
+    }
+
+    // Wait until every task posted so far, and every task those posted, has run
+    void wait() {
+        unique_lock<mutex> lock(idleMutex);
+        idle.wait(lock, [this] { return pending == 0; });
+    }
+
+private:
+    static const int STRIPE = 64;  // Adjacent slots per shard stripe, so workers rarely share cache lines
+
+    struct Queue {
+        mutex lock;
+        condition_variable ready;
+        deque<function<void()>> tasks;
+        bool stopping = false;
+    };
+
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> threads;
+    mutex idleMutex;
+    condition_variable idle;
+    size_t pending = 0;  // Tasks posted but not yet finished
+
+    void run(Queue& queue) {
+        unique_lock<mutex> lock(queue.lock);
+        while (true) {
+            queue.ready.wait(lock, [&queue] { return queue.stopping || !queue.tasks.empty(); });
+            if (queue.tasks.empty()) {
+                return;  // Stopping, and nothing left to run
+            }
+            function<void()> task = move(queue.tasks.front());
+            queue.tasks.pop_front();
+            lock.unlock();
+            task();
+            {
+                lock_guard<mutex> idleLock(idleMutex);
+                if (--pending == 0) {
+                    idle.notify_all();
+                }
+            }
+            lock.lock();
+        }
+    }
+};
+
 // Class to manage the combat game system and players
 class CombatGameManager {
+public:
+    static const size_t DEFAULT_MAX_PLAYERS = 6;  // Player limit unless configured otherwise
+
 private:
-    map<int, shared_ptr<Player>> players; // Map to store players by their unique number
+    vector<Player> players;  // All players, stored contiguously in creation order
+    PlayerIndex index;       // Player number -> position in players
+    Leaderboard leaderboard; // Players ranked by points
+    size_t maxPlayers;       // Player limit
+    bool rankingSuspended = false;  // Leaderboard not updated per fight during a large import
+    unique_ptr<ShardWorkers> workers;  // Started by the first parallel import, then kept
+
+    static const size_t INGEST_CHUNK = 1 << 20;  // Bytes read at a time by ingestFights
+
+    // Add a fight result to the player in `slot` and re-rank them
+    void award(int slot, int result) {
+        Player& player = players[slot];
+        const int oldPoints = player.getPoints();
+        player.addFightResult(result);
+        if (!rankingSuspended) {
+            leaderboard.update(player.getNumber(), oldPoints, player.getPoints());
+        }
+    }
+
+    void rebuildLeaderboard() {
+        vector<pair<int, int>> ranked;
+        ranked.reserve(players.size());
+        for (const Player& player : players) {
+            ranked.emplace_back(player.getPoints(), player.getNumber());
+        }
+        leaderboard.rebuild(ranked);
+    }
+
+    // Parse an unsigned or negative decimal integer, skipping blanks before it
+    static bool parseNumber(const char*& p, const char* end, int& value) {
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+        const bool negative = p < end && *p == '-';
+        if (negative) {
+            ++p;
+        }
+        if (p == end || *p < '0' || *p > '9') {
+            return false;
+        }
+        long long number = 0;
+        while (p < end && *p >= '0' && *p <= '9' && number <= 0x7FFFFFFF) {
+            number = number * 10 + (*p++ - '0');
+        }
+        if (number > 0x7FFFFFFF) {
+            return false;
+        }
+        value = static_cast<int>(negative ? -number : number);
+        return true;
+    }
 
-    // Function to find a player by their number
-    shared_ptr<Player> findPlayer(int number) const {
-        auto it = players.find(number);
-        return (it != players.end()) ? it->second : nullptr;
+    // Skip the separator between two fields: blanks, at most one comma, or both
+    static bool skipSeparator(const char*& p, const char* end) {
+        const char* start = p;
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+        if (p < end && *p == ',') {
+            ++p;
+        }
+        return p != start;
+    }
+
+    // Parse the text line [p, end): "player1 player2 result", blank and '#' lines skipped
+    static void parseLine(const char* p, const char* end, size_t row, vector<FightRow>& batch) {
+        if (end > p && end[-1] == '\r') {
+            --end;
+        }
+        const char* q = p;
+        while (q < end && (*q == ' ' || *q == '\t')) {
+            ++q;
+        }
+        if (q == end || *q == '#') {
+            return;
+        }
+        FightRow fight = {0, 0, 0, row, nullptr};
+        const bool parsed = parseNumber(p, end, fight.player1) && skipSeparator(p, end)
+                         && parseNumber(p, end, fight.player2) && skipSeparator(p, end)
+                         && parseNumber(p, end, fight.result);
+        while (p < end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+        if (p < end && *p == ',') {
+            fight.error = "empty field";  // A stray comma, as in ",1,2,3", "1,,2,3" or "1,2,3,"
+        } else if (!parsed || p != end) {
+            fight.error = "malformed row";
+        }
+        batch.push_back(fight);
+    }
+
+    // Record a batch of parsed fights, on `threads` threads if the ranking is rebuilt afterwards
+    void applyBatch(const vector<FightRow>& batch, IngestReport& report, unsigned threads) {
+        // Re-ranking after every fight costs more than one rebuild once the import
+        // is a sizeable fraction of the player count
+        if (!rankingSuspended && batch.size() * 16 > players.size()) {
+            rankingSuspended = true;
+        }
+        if (rankingSuspended && threads > 1 && batch.size() >= threads) {
+            applyInParallel(batch, report, threads);
+        } else {
+            applySerially(batch, report);
+        }
+    }
+
+    void applySerially(const vector<FightRow>& batch, IngestReport& report) {
+        for (const FightRow& fight : batch) {
+            const int slot1 = index.find(fight.player1);
+            const int slot2 = index.find(fight.player2);
+            if (fight.error) {
+                report.reject(fight.row, fight.error);
+            } else if (slot1 < 0 || slot2 < 0) {
+                report.reject(fight.row, "unknown player");
+            } else if (!applyResult(slot1, slot2, fight.result)) {
+                report.reject(fight.row, "invalid result");
+            } else {
+                ++report.applied;
+            }
+        }
+    }
+
+    struct Award {
+        int slot;
+        int points;
+    };
+
+    // Keep `threads` shard workers running
+    void useWorkers(unsigned threads) {
+        if (!workers || workers->size() != threads) {
+            workers.reset();
+            workers.reset(new ShardWorkers(threads));
+        }
+    }
+
+    // Check the fights [first, last) and post their point awards to the shard workers,
+    // one task per shard; returns the outcome of these rows
+    IngestReport postAwards(const FightRow* first, const FightRow* last) {
+        IngestReport report;
+        vector<vector<Award>> awards(workers->size());  // [shard]
+        for (const FightRow* fight = first; fight != last; ++fight) {
+            const int slot1 = fight->error ? -1 : index.find(fight->player1);
+            const int slot2 = fight->error ? -1 : index.find(fight->player2);
+            int points1, points2;
+            if (fight->error) {
+                report.reject(fight->row, fight->error);
+                continue;
+            } else if (slot1 < 0 || slot2 < 0) {
+                report.reject(fight->row, "unknown player");
+                continue;
+            } else if (fight->result == 1) {
+                points1 = 10, points2 = 0;
+            } else if (fight->result == 2) {
+                points1 = 0, points2 = 10;
+            } else if (fight->result == 3) {
+                points1 = 5, points2 = 5;
+            } else {
+                report.reject(fight->row, "invalid result");
+                continue;
+            }
+            awards[workers->shardOf(slot1)].push_back({slot1, points1});
+            awards[workers->shardOf(slot2)].push_back({slot2, points2});
+            ++report.applied;
+        }
+        for (unsigned shard = 0; shard < awards.size(); ++shard) {
+            if (awards[shard].empty()) {
+                continue;
+            }
+            workers->post(shard, [this, shardAwards = move(awards[shard])] {
+                for (const Award& award : shardAwards) {
+                    players[award.slot].addFightResult(award.points);
+                }
+            });
+        }
+        return report;
+    }
+
+    // Record a batch on `threads` shard workers: worker t checks slice t of the batch
+    // and posts its awards to the workers owning the receiving players. A player's
+    // awards may arrive in any order, which gives the same statistics as recording the
+    // fights one by one, since they only add up.
+    void applyInParallel(const vector<FightRow>& batch, IngestReport& report, unsigned threads) {
+        useWorkers(threads);
+        vector<IngestReport> reports(threads);
+        for (unsigned t = 0; t < threads; ++t) {
+            workers->post(t, [&, t] {
+                const FightRow* rows = batch.data();
+                reports[t] = postAwards(rows + batch.size() * t / threads, rows + batch.size() * (t + 1) / threads);
+            });
+        }
+        workers->wait();
+        for (const IngestReport& slice : reports) {
+            report.merge(slice);
+        }
+    }
+
+    // Update both players' statistics for a result code (1: player 1 wins, 2: player 2 wins, 3: tie)
+    bool applyResult(int slot1, int slot2, int result) {
+        if (result == 1) {
+            award(slot1, 10);
+            award(slot2, 0);
+        } else if (result == 2) {
+            award(slot2, 10);
+            award(slot1, 0);
+        } else if (result == 3) {
+            award(slot1, 5);
+            award(slot2, 5);
+        } else {
+            return false;
+        }
+        return true;
     }
 
 public:
+    explicit CombatGameManager(size_t maxPlayers = DEFAULT_MAX_PLAYERS) : maxPlayers(maxPlayers) {}
+
+    // Change the player limit; reserves room for that many players
+    void setMaxPlayers(size_t limit) {
+        maxPlayers = limit;
+        players.reserve(limit);
+        index.reserve(limit);
+    }
+
+    size_t getMaxPlayers() const { return maxPlayers; }
+    size_t size() const { return players.size(); }
+    bool isFull() const { return players.size() >= maxPlayers; }
+
+    // Function to find a player by their number (nullptr if there is none). The
+    // pointer is valid until the next player is added.
+    Player* findPlayer(int number) {
+        const int slot = index.find(number);
+        return slot >= 0 ? &players[slot] : nullptr;
+    }
+
+    const Player* findPlayer(int number) const {
+        const int slot = index.find(number);
+        return slot >= 0 ? &players[slot] : nullptr;
+    }
+
+    // Add a player without prompting; false if the limit is reached or the number is taken
+    bool addPlayer(Player player) {
+        if (isFull() || index.find(player.getNumber()) >= 0) {
+            return false;
+        }
+        index.insert(player.getNumber(), static_cast<int>(players.size()));
+        leaderboard.insert(player.getPoints(), player.getNumber());
+        players.push_back(move(player));
+        return true;
+    }
+
+    // Record a fight without prompting (result 1: player 1 wins, 2: player 2 wins, 3: tie);
+    // false if a player number or the result is invalid
+    bool recordFight(int player1Num, int player2Num, int result) {
+        const int slot1 = index.find(player1Num);
+        const int slot2 = index.find(player2Num);
+        return slot1 >= 0 && slot2 >= 0 && applyResult(slot1, slot2, result);
+    }
+
+    // Current winner: most points, the lowest number among equals (nullptr if there are no players)
+    const Player* getLeader() const {
+        return players.empty() ? nullptr : findPlayer(leaderboard.getLeader());
+    }
+
+    // 1-based leaderboard position of a player (0 if there is no such player)
+    size_t getRank(int number) const {
+        const Player* player = findPlayer(number);
+        return player ? leaderboard.rankOf(player->getPoints(), number) : 0;
+    }
+
+    // The first `count` players of the leaderboard, in order
+    vector<const Player*> getTopPlayers(size_t count) const {
+        vector<const Player*> top;
+        for (int number : leaderboard.top(count)) {
+            top.push_back(findPlayer(number));
+        }
+        return top;
+    }
+
+    // Record every fight of a fight log, either text (one "player1 player2 result" row
+    // per line, separated by blanks or commas) or binary (FIGHT_LOG_MAGIC, then 12-byte
+    // records). The log is read and applied in large chunks, each on `threads` threads
+    // if it is large enough (see recordFights); rows that cannot be recorded are
+    // counted and the first few listed in the report.
+    IngestReport ingestFights(istream& in, unsigned threads = 1) {
+        IngestReport report;
+        vector<char> buffer(INGEST_CHUNK);
+        vector<FightRow> batch;
+        in.read(buffer.data(), buffer.size());
+        size_t filled = static_cast<size_t>(in.gcount());
+        const bool binary = filled >= sizeof(FIGHT_LOG_MAGIC)
+                         && memcmp(buffer.data(), FIGHT_LOG_MAGIC, sizeof(FIGHT_LOG_MAGIC)) == 0;
+        size_t start = binary ? sizeof(FIGHT_LOG_MAGIC) : 0;
+        size_t row = 0;
+
+        while (true) {
+            const char* p = buffer.data() + start;
+            const char* end = buffer.data() + filled;
+            batch.clear();
+            if (binary) {
+                for (; end - p >= 12; p += 12) {
+                    FightRow fight = {0, 0, 0, ++row, nullptr};
+                    uint32_t fields[3];
+                    for (int i = 0; i < 3; ++i) {
+                        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(p + 4 * i);
+                        fields[i] = bytes[0] | bytes[1] << 8 | bytes[2] << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+                    }
+                    fight.player1 = static_cast<int>(fields[0]);
+                    fight.player2 = static_cast<int>(fields[1]);
+                    fight.result = static_cast<int>(fields[2]);
+                    batch.push_back(fight);
+                }
+            } else {
+                for (const char* newline; (newline = static_cast<const char*>(memchr(p, '\n', end - p))); p = newline + 1) {
+                    parseLine(p, newline, ++row, batch);
+                }
+            }
+            applyBatch(batch, report, threads);
+
+            // Keep the incomplete row at the front of the buffer and read more after it
+            const size_t leftover = end - p;
+            memmove(buffer.data(), p, leftover);
+            if (leftover == buffer.size()) {
+                buffer.resize(buffer.size() * 2);  // A single line longer than the buffer
+            }
+            in.read(buffer.data() + leftover, buffer.size() - leftover);
+            filled = leftover + static_cast<size_t>(in.gcount());
+            start = 0;
+            if (filled == leftover) {
+                batch.clear();
+                if (leftover > 0 && binary) {
+                    batch.push_back({0, 0, 0, ++row, "truncated record"});
+                } else if (leftover > 0) {
+                    parseLine(buffer.data(), buffer.data() + leftover, ++row, batch);
+                }
+                applyBatch(batch, report, threads);
+                break;
+            }
+        }
+
+        if (rankingSuspended) {
+            rankingSuspended = false;
+            rebuildLeaderboard();
+        }
+        return report;
+    }
+
+    // Function to import fight results from a fight log file
+    void importFights() {
+        string path;
+        cout << "Enter the path of the fight log: ";
+        cout << endl;
+        cin >> path;  // Input the file path
+
+        ifstream file(path, ios::binary);
+        if (!file) {
+            cout << "Could not open " << path << ".\n";
+            return;
+        }
+        const IngestReport report = ingestFights(file, max(1u, thread::hardware_concurrency()));
+        cout << "Recorded " << report.applied << " fights, rejected " << report.rejected << " rows.\n";
+        for (const auto& rejection : report.rejectedRows) {
+            cout << "Row " << rejection.first << ": " << rejection.second << '\n';
+        }
+        cout << endl;
+    }
+
+    // Record a batch of fights, rejecting the rows that cannot be recorded. Large
+    // batches are applied on `threads` threads and the leaderboard rebuilt afterwards;
+    // the outcome is the same as recording the fights one by one. Players must not be
+    // added while this runs.
+    IngestReport recordFights(const vector<FightRow>& fights, unsigned threads = 1) {
+        IngestReport report;
+        applyBatch(fights, report, threads);
+        if (rankingSuspended) {
+            rankingSuspended = false;
+            rebuildLeaderboard();
+        }
+        return report;
+    }
+
+    // Record fights handed in by several threads at once: call beginConcurrentFights
+    // once, then submitFights from any number of threads, then endConcurrentFights,
+    // which waits for the awards and re-ranks. Each caller checks its own rows; the
+    // awards are applied by `threads` shard workers. Players must not be added until
+    // endConcurrentFights returns.
+    void beginConcurrentFights(unsigned threads) {
+        useWorkers(threads);
+        rankingSuspended = true;
+    }
+
+    IngestReport submitFights(const vector<FightRow>& fights) {
+        return postAwards(fights.data(), fights.data() + fights.size());
+    }
+
+    void endConcurrentFights() {
+        workers->wait();
+        rankingSuspended = false;
+        rebuildLeaderboard();
+    }
+
     // Function to create a new player
     void createPlayer() {
-        if (players.size() >= 6) {
-            cout << "Maximum players reached!\n";  // Limit of 6 players
+        if (isFull()) {
+            cout << "Maximum players reached!\n";  // Configured player limit
             cout << endl;
             return;
         }
-        auto player = make_shared<Player>();  // Create a shared pointer for the player
-        cin >> *player;  // Input player data
-        if (players.count(player->getNumber())) {  // Check if the player already exists
+        Player player;
+        cin >> player;  // Input player data
+        if (findPlayer(player.getNumber())) {  // Check if the player already exists
             cout << "Player with this number already exists. Try again.\n";
             cout << endl;
         } else {
-            players[player->getNumber()] = player;  // Add player to the map
+            addPlayer(move(player));  // Add player to the table
             cout << "Player created successfully.\n";
             cout << endl;
         }
@@ -115,8 +1198,8 @@ public:
         cout << endl;
         cin >> player2Num;  // Input Player 2 number
 
-        auto player1 = findPlayer(player1Num);  // Find Player 1
-        auto player2 = findPlayer(player2Num);  // Find Player 2
+        Player* player1 = findPlayer(player1Num);  // Find Player 1
+        Player* player2 = findPlayer(player2Num);  // Find Player 2
 
         if (!player1 || !player2) {
             cout << "Invalid player numbers. Try again.\n";  // Handle invalid player numbers
@@ -135,24 +1218,18 @@ public:
         cin >> result;  // Input the result of the game
 
         // Update player statistics based on the game result
-        if (result == 1) {
-            player1->addFightResult(10);  // Player 1 wins
-            player2->addFightResult(0);   // Player 2 loses
+        if (!recordFight(player1Num, player2Num, result)) {
+            cout << "Invalid result entered. Try again.\n";  // Handle invalid result
+        } else if (result == 1) {
             cout << player1->getName() << " has won the game.\n";
             cout << "Comparison: " << (player1->getHeight() - player2->getHeight()) << " cm taller and "
                  << (player1->getWeight() - player2->getWeight()) << " kg heavier.\n";
         } else if (result == 2) {
-            player2->addFightResult(10);  // Player 2 wins
-            player1->addFightResult(0);   // Player 1 loses
             cout << player2->getName() << " has won the game.\n";
             cout << "Comparison: " << (player2->getHeight() - player1->getHeight()) << " cm taller and "
                  << (player2->getWeight() - player1->getWeight()) << " kg heavier.\n";
-        } else if (result == 3) {
-            player1->addFightResult(5);  // Tie result for both players
-            player2->addFightResult(5);
-            cout << "The game is a tie.\n";
         } else {
-            cout << "Invalid result entered. Try again.\n";  // Handle invalid result
+            cout << "The game is a tie.\n";
         }
     }
 
@@ -162,9 +1239,19 @@ public:
             cout << "No players available.\n";  // Handle empty player list
             return;
         }
-        for (const auto& pair : players) {
-            cout << *pair.second << endl;  // Display each player
+        // Display each player, ordered by player number
+        vector<const Player*> ordered;
+        ordered.reserve(players.size());
+        for (const Player& player : players) {
+            ordered.push_back(&player);
+        }
+        sort(ordered.begin(), ordered.end(), [](const Player* a, const Player* b) {
+            return a->getNumber() < b->getNumber();
+        });
+        for (const Player* player : ordered) {
+            cout << *player << '\n';
         }
+        cout << flush;
     }
 
     // Function to display the winner based on points
@@ -174,20 +1261,461 @@ public:
             return;
         }
 
-        // Find the player with the highest points
-        auto winner = max_element(players.begin(), players.end(),
-                                  [](const auto& a, const auto& b) {
-                                      return a.second->getPoints() < b.second->getPoints();
-                                  });
+        // The leader has the highest points (the lowest number among equals)
+        cout << "Winner: " << *getLeader() << endl;  // Display the winner
+        cout << endl;
+    }
 
-        cout << "Winner: " << *winner->second << endl;  // Display the winner
+    // Function to generate and display a tournament schedule, seeded by the leaderboard
+    void displaySchedule() const {
+        if (players.size() < 2) {
+            cout << "At least two players are needed.\n";  // Handle too few players
+            return;
+        }
+        cout << "Enter the tournament format:\n";
+        cout << endl;
+        cout << "1. Round robin\n";
+        cout << endl;
+        cout << "2. Single elimination\n";
+        cout << endl;
+        cout << "3. Double elimination\n";
+        cout << endl;
+        int format;
+        cin >> format;  // Input the format
+        if (format < 1 || format > 3) {
+            cout << "Invalid format entered. Try again.\n";  // Handle invalid format
+            return;
+        }
+        cout << "Enter the maximum number of fights per player in this tournament (0 for no limit; "
+                "fights already recorded are not counted): ";
+        cout << endl;
+        int maxFights;
+        cin >> maxFights;  // Input the fight limit
+
+        TournamentScheduler scheduler(getTopPlayers(players.size()), maxFights);
+        const vector<Bout>& bouts = scheduler.schedule(static_cast<TournamentScheduler::Format>(format - 1));
+        if (bouts.empty()) {
+            cout << "No compatible bouts could be scheduled.\n";
+            return;
+        }
+        static const char* const bracketNames[] = {"Pool", "Winners bracket", "Losers bracket", "Grand final"};
+        auto describe = [](const Entrant& entrant) {
+            if (entrant.player) {
+                return entrant.player->getName();
+            }
+            return string(entrant.loser ? "Loser" : "Winner") + " of bout " + to_string(entrant.bout + 1);
+        };
+        for (size_t i = 0; i < bouts.size(); ++i) {
+            const Bout& bout = bouts[i];
+            cout << "Bout " << i + 1 << " (" << bracketNames[bout.bracket] << " " << bout.group << ", round "
+                 << bout.round << "): " << describe(bout.first) << " vs " << describe(bout.second) << '\n';
+        }
+        cout << endl;
+    }
+
+    // Function to display the first entries of the leaderboard
+    void displayLeaderboard() const {
+        if (players.empty()) {
+            cout << "No players available.\n";  // Handle empty player list
+            return;
+        }
+        cout << "Enter the number of places to show: ";
+        cout << endl;
+        size_t count;
+        cin >> count;  // Input the number of places
+
+        size_t rank = 0;
+        for (const Player* player : getTopPlayers(count)) {
+            cout << ++rank << ". " << *player << '\n';
+        }
         cout << endl;
     }
 };
 
-// Main function to run the program
-int main() {
+// Benchmark: a league of `count` players, looked up and recorded fights by player number
+void benchmarkPlayerStore(size_t count) {
+    mt19937 random(1);
+    vector<int> numbers(count);
+    for (size_t i = 0; i < count; ++i) {
+        numbers[i] = static_cast<int>(i * 7 + 1000);  // Sparse, unique player numbers
+    }
+    shuffle(numbers.begin(), numbers.end(), random);
+
+    CombatGameManager manager(count);
+    manager.setMaxPlayers(count);
+    auto start = chrono::steady_clock::now();
+    for (int number : numbers) {
+        manager.addPlayer(Player(number, "Surname", "First", 150 + number % 50, 50.0f + number % 60, 1990));
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << count << " players: created " << count / elapsed.count() << " players/s";
+
+    const size_t operations = 10000000;
+    vector<int> picks(operations);
+    for (int& pick : picks) {
+        pick = numbers[random() % count];
+    }
+
+    start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (int number : picks) {
+        checksum += manager.findPlayer(number)->getPoints();
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    cout << ", " << operations / elapsed.count() << " lookups/s";
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i + 1 < operations; i += 2) {
+        checksum += manager.recordFight(picks[i], picks[i + 1], 1 + static_cast<int>(i % 3));
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    cout << ", " << operations / 2 / elapsed.count() << " fights/s";
+
+    // The previous storage, for comparison
+    map<int, shared_ptr<Player>> byNumber;
+    for (int number : numbers) {
+        byNumber[number] = make_shared<Player>(number, "Surname", "First", 150, 50.0f, 1990);
+    }
+    start = chrono::steady_clock::now();
+    for (int number : picks) {
+        checksum += byNumber.find(number)->second->getPoints();
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    cout << " (map of shared_ptr: " << operations / elapsed.count() << " lookups/s, checksum " << checksum << ")" << endl;
+}
+
+// Benchmark: leaderboard queries while fights are recorded, checked against a full sort
+void benchmarkLeaderboard(size_t count) {
+    mt19937 random(2);
+    CombatGameManager manager(count);
+    manager.setMaxPlayers(count);
+    for (size_t i = 0; i < count; ++i) {
+        manager.addPlayer(Player(static_cast<int>(i), "Surname", "First", 170, 70.0f, 1990));
+    }
+
+    const size_t fights = 5000000;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < fights; ++i) {
+        manager.recordFight(random() % count, random() % count, 1 + random() % 3);
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    cout << count << " players: " << fights / elapsed.count() << " ranked fights/s";
+
+    const size_t queries = 1000000;
+    long long checksum = 0;
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries; ++i) {
+        checksum += manager.getLeader()->getNumber();
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    cout << ", " << queries / elapsed.count() << " winner queries/s";
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries; ++i) {
+        checksum += manager.getRank(random() % count);
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    cout << ", " << queries / elapsed.count() << " rank queries/s";
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < queries; ++i) {
+        checksum += manager.getTopPlayers(10).size();
+    }
+    elapsed = chrono::steady_clock::now() - start;
+    cout << ", " << queries / elapsed.count() << " top-10 queries/s";
+
+    // Compare with the ranking rules applied by a full sort
+    vector<const Player*> ranked;
+    for (size_t i = 0; i < count; ++i) {
+        ranked.push_back(manager.findPlayer(static_cast<int>(i)));
+    }
+    start = chrono::steady_clock::now();
+    sort(ranked.begin(), ranked.end(), [](const Player* a, const Player* b) {
+        return a->getPoints() > b->getPoints() || (a->getPoints() == b->getPoints() && a->getNumber() < b->getNumber());
+    });
+    elapsed = chrono::steady_clock::now() - start;
+    bool consistent = manager.getTopPlayers(100) == vector<const Player*>(ranked.begin(), ranked.begin() + min<size_t>(100, count));
+    for (size_t i = 0; i < count; i += 997) {
+        consistent = consistent && manager.getRank(ranked[i]->getNumber()) == i + 1;
+    }
+    cout << " (full sort: " << elapsed.count() * 1000 << " ms; ranking "
+         << (consistent ? "matches" : "DIFFERS") << ", checksum " << checksum << ")" << endl;
+}
+
+// Benchmark: importing a fight log of `fights` rows (1% of them invalid) as text and binary
+void benchmarkIngestion(size_t count, size_t fights) {
+    mt19937 random(3);
+    string text;
+    string binary(FIGHT_LOG_MAGIC, sizeof(FIGHT_LOG_MAGIC));
+    for (size_t i = 0; i < fights; ++i) {
+        uint32_t fields[3] = {static_cast<uint32_t>(random() % count), static_cast<uint32_t>(random() % count),
+                              static_cast<uint32_t>(1 + random() % 3)};
+        if (i % 100 == 99) {
+            fields[i % 200 == 99 ? 0 : 2] = static_cast<uint32_t>(count + 7);  // Unknown player or invalid result
+        }
+        text += to_string(fields[0]) + ' ' + to_string(fields[1]) + ' ' + to_string(fields[2]) + '\n';
+        for (uint32_t field : fields) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                binary += static_cast<char>(field >> shift & 0xFF);
+            }
+        }
+    }
+
+    for (const string* log : {&text, &binary}) {
+        CombatGameManager manager(count);
+        manager.setMaxPlayers(count);
+        for (size_t i = 0; i < count; ++i) {
+            manager.addPlayer(Player(static_cast<int>(i), "Surname", "First", 170, 70.0f, 1990));
+        }
+        istringstream in(*log);
+        auto start = chrono::steady_clock::now();
+        const IngestReport report = manager.ingestFights(in);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << count << " players, " << (log == &text ? "text" : "binary") << " log of " << log->size() / 1000000
+             << " MB: " << fights / elapsed.count() << " rows/s (" << report.applied << " recorded, "
+             << report.rejected << " rejected, leader " << manager.getLeader()->getNumber() << ")" << endl;
+    }
+}
+
+// Random fights among `count` players with a few popular players and about 1% invalid rows
+vector<FightRow> makeRandomFights(size_t count, size_t fights, unsigned seed) {
+    mt19937 random(seed);
+    vector<FightRow> rows(fights);
+    for (size_t i = 0; i < fights; ++i) {
+        FightRow& row = rows[i];
+        row.player1 = static_cast<int>(i % 10 == 0 ? random() % 8 : random() % count);
+        row.player2 = static_cast<int>(random() % count);
+        row.result = 1 + random() % 3;
+        row.row = i + 1;
+        row.error = nullptr;
+        if (i % 100 == 99) {
+            row.result = 4;
+        } else if (i % 100 == 49) {
+            row.player2 = -1;
+        }
+    }
+    return rows;
+}
+
+CombatGameManager makeLeague(size_t count) {
+    CombatGameManager manager(count);
+    manager.setMaxPlayers(count);
+    for (size_t i = 0; i < count; ++i) {
+        manager.addPlayer(Player(static_cast<int>(i), "Surname", "First", 150 + i % 50, 50.0f + i % 60, 1990));
+    }
+    return manager;
+}
+
+// Benchmark: recording a large batch of fights on several threads, then the same
+// fights handed in by as many callers in batches of 100000
+void benchmarkConcurrentFights(size_t count, size_t fights) {
+    const vector<FightRow> rows = makeRandomFights(count, fights, 4);
+    cout << "Hardware threads: " << thread::hardware_concurrency() << endl;
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        CombatGameManager manager = makeLeague(count);
+        auto start = chrono::steady_clock::now();
+        const IngestReport report = manager.recordFights(rows, threads);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << count << " players, " << threads << " threads: " << fights / elapsed.count() << " fights/s ("
+             << report.applied << " recorded)";
+
+        manager = makeLeague(count);
+        start = chrono::steady_clock::now();
+        manager.beginConcurrentFights(threads);
+        vector<thread> callers;
+        for (unsigned c = 0; c < threads; ++c) {
+            callers.emplace_back([&, c] {
+                for (size_t first = c * 100000; first < rows.size(); first += threads * 100000) {
+                    const vector<FightRow> batch(rows.begin() + first, rows.begin() + min(rows.size(), first + 100000));
+                    manager.submitFights(batch);
+                }
+            });
+        }
+        for (thread& caller : callers) {
+            caller.join();
+        }
+        manager.endConcurrentFights();
+        elapsed = chrono::steady_clock::now() - start;
+        cout << ", " << threads << " callers: " << fights / elapsed.count() << " fights/s" << endl;
+    }
+}
+
+// Benchmark: schedules for a league of `count` players, of correlated or independent
+// height and weight, checked by playing every bout with a random winner. Every
+// player left without a bout must have no compatible opponent outside a two-player
+// group (checked for up to 200 such players).
+void benchmarkScheduler(size_t count, bool correlated) {
+    mt19937 random(6);
+    CombatGameManager manager(count);
+    manager.setMaxPlayers(count);
+    for (size_t i = 0; i < count; ++i) {
+        const int height = 150 + random() % 60;
+        const float weight = correlated ? 40 + (height - 150) * 0.8f + random() % 16 : 40 + random() % 80;
+        manager.addPlayer(Player(static_cast<int>(i), "Surname", "First", height, weight, 1990));
+    }
+    const vector<const Player*> seeded = manager.getTopPlayers(count);
+
+    const pair<TournamentScheduler::Format, int> formats[] = {
+        {TournamentScheduler::ROUND_ROBIN, 3}, {TournamentScheduler::SINGLE_ELIMINATION, 0},
+        {TournamentScheduler::SINGLE_ELIMINATION, 4}, {TournamentScheduler::DOUBLE_ELIMINATION, 0},
+        {TournamentScheduler::DOUBLE_ELIMINATION, 6}};
+    static const char* const formatNames[] = {"round robin", "single elimination", "double elimination"};
+    for (const auto& format : formats) {
+        TournamentScheduler scheduler(seeded, format.second);
+        auto start = chrono::steady_clock::now();
+        const vector<Bout>& bouts = scheduler.schedule(format.first);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        vector<const Player*> winners(bouts.size()), losers(bouts.size());
+        vector<int> fights(count);
+        vector<int> groupOf(count, 0);    // Group each player was first seen in
+        vector<int> groupSize(bouts.size() + 1);  // Distinct players seen per group
+        bool valid = true;
+        for (size_t i = 0; i < bouts.size(); ++i) {
+            auto resolve = [&](const Entrant& entrant) {
+                return entrant.player ? entrant.player : entrant.loser ? losers[entrant.bout] : winners[entrant.bout];
+            };
+            const Player* first = resolve(bouts[i].first);
+            const Player* second = resolve(bouts[i].second);
+            valid = valid && (*first >= *second || *second >= *first);
+            const bool firstWins = random() % 2 == 0;
+            winners[i] = firstWins ? first : second;
+            losers[i] = firstWins ? second : first;
+            for (const Player* player : {first, second}) {
+                const int number = player->getNumber();
+                if (fights[number]++ == 0) {
+                    groupOf[number] = bouts[i].group;
+                    ++groupSize[bouts[i].group];
+                }
+                valid = valid && (format.second == 0 || fights[number] <= format.second);
+            }
+        }
+
+        size_t leftOut = 0;
+        for (size_t p = 0; p < count; ++p) {
+            if (fights[p] > 0 || ++leftOut > 200) {
+                continue;
+            }
+            const Player& player = *manager.findPlayer(static_cast<int>(p));
+            for (size_t q = 0; q < count; ++q) {
+                const Player& other = *manager.findPlayer(static_cast<int>(q));
+                if (q != p && (player >= other || other >= player)) {
+                    valid = valid && fights[q] > 0 && groupSize[groupOf[q]] == 2;
+                }
+            }
+        }
+        cout << count << (correlated ? " players, " : " players (independent sizes), ") << formatNames[format.first]
+             << ", limit " << format.second << ": " << bouts.size() << " bouts in " << scheduler.getGroupCount()
+             << " groups, " << leftOut << " players left out, " << elapsed.count() * 1000 << " ms ("
+             << (valid ? "compatible, within the limit, nobody dropped" : "INVALID") << ")" << endl;
+    }
+}
+
+// Text fight log rows: blanks and single commas separate fields, empty fields are rejected
+bool testFightLogParsing() {
+    CombatGameManager manager = makeLeague(4);
+    istringstream in("1 2 1\n1,2,2\n1 , 2 ,3\n\t0\t3\t1\r\n# comment\n\n"
+                     ",1,2,3\n1,,2,3\n1,2,3,\n1 2\n1 2 3 4\n1-2 3\n");
+    const IngestReport report = manager.ingestFights(in);
+    const vector<pair<size_t, string>> rejected = {{7, "empty field"}, {8, "empty field"}, {9, "empty field"},
+                                                   {10, "malformed row"}, {11, "malformed row"}, {12, "malformed row"}};
+    const bool passed = report.applied == 4 && report.rejected == rejected.size() && report.rejectedRows == rejected;
+    cout << "Fight log parsing: " << (passed ? "PASS" : "FAIL") << endl;
+    return passed;
+}
+
+// Stress test: recording fights on several threads must give the same players,
+// ranking and report as recording them one by one
+bool runStressTest() {
+    const size_t count = 20000;
+    const vector<FightRow> rows = makeRandomFights(count, 2000000, 5);
+
+    CombatGameManager serial = makeLeague(count);
+    IngestReport expected;
+    for (size_t first = 0; first < rows.size(); first += 1000) {
+        // Batches small enough to keep the ranking updated fight by fight
+        const vector<FightRow> batch(rows.begin() + first, rows.begin() + min(rows.size(), first + 1000));
+        expected.merge(serial.recordFights(batch));
+    }
+
+    // Same players and ranking as the serial replay
+    auto samePlayers = [&](CombatGameManager& concurrent) {
+        bool same = concurrent.getTopPlayers(count).size() == count;
+        for (size_t i = 0; same && i < count; ++i) {
+            const Player& a = *serial.findPlayer(static_cast<int>(i));
+            const Player& b = *concurrent.findPlayer(static_cast<int>(i));
+            same = a.getPoints() == b.getPoints() && a.getWins() == b.getWins() && a.getTies() == b.getTies()
+                && a.getLosses() == b.getLosses() && a.getFightsParticipated() == b.getFightsParticipated()
+                && serial.getRank(a.getNumber()) == concurrent.getRank(b.getNumber());
+        }
+        return same;
+    };
+
+    bool passed = true;
+    for (unsigned threads : {2u, 3u, 4u, 8u, 16u}) {
+        CombatGameManager concurrent = makeLeague(count);
+        const IngestReport report = concurrent.recordFights(rows, threads);
+        const bool same = report.applied == expected.applied && report.rejected == expected.rejected
+                       && report.rejectedRows == expected.rejectedRows && samePlayers(concurrent);
+        cout << "Stress, " << threads << " threads, " << rows.size() << " fights: " << (same ? "PASS" : "FAIL") << endl;
+        passed = passed && same;
+    }
+
+    // Several callers submitting interleaved batches to the same manager at once
+    for (unsigned callers : {2u, 4u, 8u}) {
+        CombatGameManager concurrent = makeLeague(count);
+        concurrent.beginConcurrentFights(4);
+        vector<IngestReport> reports(callers);
+        vector<thread> threads;
+        for (unsigned c = 0; c < callers; ++c) {
+            threads.emplace_back([&, c] {
+                for (size_t first = c * 10000; first < rows.size(); first += callers * 10000) {
+                    const vector<FightRow> batch(rows.begin() + first, rows.begin() + min(rows.size(), first + 10000));
+                    reports[c].merge(concurrent.submitFights(batch));
+                }
+            });
+        }
+        for (thread& caller : threads) {
+            caller.join();
+        }
+        concurrent.endConcurrentFights();
+        IngestReport report;
+        for (const IngestReport& submitted : reports) {
+            report.merge(submitted);
+        }
+        const bool same = report.applied == expected.applied && report.rejected == expected.rejected
+                       && samePlayers(concurrent);
+        cout << "Stress, " << callers << " callers on 4 workers, " << rows.size() << " fights: "
+             << (same ? "PASS" : "FAIL") << endl;
+        passed = passed && same;
+    }
+    return passed;
+}
+
+// Main function to run the program. Arguments: "--max-players N" sets the player
+// limit, "--bench" runs the benchmarks and "--stress" the parsing check and the
+// concurrency stress test instead of the menu.
+int main(int argc, char* argv[]) {
     CombatGameManager manager;  // Create an instance of the combat game manager
+    for (int i = 1; i < argc; ++i) {
+        const string argument = argv[i];
+        if (argument == "--bench") {
+            benchmarkPlayerStore(1000000);
+            benchmarkLeaderboard(1000000);
+            benchmarkIngestion(1000000, 10000000);
+            benchmarkConcurrentFights(1000000, 10000000);
+            benchmarkScheduler(1000000, true);
+            benchmarkScheduler(20000, false);
+            return 0;
+        }
+        if (argument == "--stress") {
+            const bool parsing = testFightLogParsing();
+            return runStressTest() && parsing ? 0 : 1;
+        }
+        if (argument == "--max-players" && i + 1 < argc) {
+            manager.setMaxPlayers(strtoul(argv[++i], nullptr, 10));
+        }
+    }
     int choice;
 
     do {
@@ -204,6 +1732,12 @@ int main() {
         cout << endl;
         cout << "5. Exit\n";
         cout << endl;
+        cout << "6. Display Leaderboard\n";
+        cout << endl;
+        cout << "7. Import Fight Results\n";
+        cout << endl;
+        cout << "8. Schedule Tournament\n";
+        cout << endl;
         cout << "Enter your choice: ";
         cout << endl;
         cin >> choice;  // Input the user's choice
@@ -225,6 +1759,15 @@ int main() {
             case 5:
                 cout << "Exiting program. Goodbye!\n";  // Exit the program
                 break;
+            case 6:
+                manager.displayLeaderboard();  // Display the top of the leaderboard
+                break;
+            case 7:
+                manager.importFights();  // Record the fights of a fight log
+                break;
+            case 8:
+                manager.displaySchedule();  // Generate a tournament schedule
+                break;
             default:
                 cout << "Invalid choice. Try again.\n";  // Handle invalid input
         }
@@ -1,9 +1,12 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <cstdlib>
+#include <cerrno>
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <unordered_map>
 
 // Class representing a player in the combat game
 class Player {
@@ -69,7 +72,7 @@ class Player {
         // Getters
         int getNumber() const { return number; }
         int getFights() const { return fights; }
-        const std::string& getFullName() const { return firstname + " " + surname; }
+        std::string getFullName() const { return firstname + " " + surname; }
         int getHeightDifference(const Player& other) const { return height - other.height; }
         double getWeightDifference(const Player& other) const { return weight - other.weight; }
 };
@@ -77,21 +80,35 @@ class Player {
 // Class managing the combat game system
 class CombatGameManager {
     private:
-        std::vector<std::shared_ptr<Player>> players;
+        std::vector<Player> players;                    // Players stored contiguously, in creation order
+        std::unordered_map<int, std::size_t> index;     // Player number -> position in players
+        std::size_t max_players;
+
+        // Player with the given number, or nullptr
+        Player* findPlayer(int number) {
+            auto it = index.find(number);
+            return it != index.end() ? &players[it->second] : nullptr;
+        }
 
     public:
+        explicit CombatGameManager(std::size_t max_players = 6) : max_players(max_players) {
+            players.reserve(max_players);
+            index.reserve(max_players);
+        }
+
         void createPlayer() {
-            if (players.size() >= 6) {
+            if (players.size() >= max_players) {
                 std::cout << "Maximum number of players reached.\n";
                 return;
             }
 
-            auto player = std::make_shared<Player>(0, "", "", 0, 0.0, 0);
-            std::cin >> *player;
-            if (std::any_of(players.begin(), players.end(), [&](const auto& p) { return p->getNumber() == player->getNumber(); })) {
+            Player player(0, "", "", 0, 0.0, 0);
+            std::cin >> player;
+            if (index.count(player.getNumber())) {
                 std::cout << "Player number must be unique.\n";
             } else {
-                players.push_back(player);
+                index.emplace(player.getNumber(), players.size());
+                players.push_back(std::move(player));
                 std::cout << "Player added successfully.\n";
             }
         }
@@ -108,19 +125,15 @@ class CombatGameManager {
     std::cout << "Enter player 2 number: ";
     std::cin >> p2_num;
 
-    auto it1 = std::find_if(players.begin(), players.end(), [&](const auto& p) { return p->getNumber() == p1_num; });
-    auto it2 = std::find_if(players.begin(), players.end(), [&](const auto& p) { return p->getNumber() == p2_num; });
+    Player* player1 = findPlayer(p1_num);
+    Player* player2 = findPlayer(p2_num);
 
     // Check if both players exist
-    if (it1 == players.end() || it2 == players.end()) {
+    if (!player1 || !player2) {
         std::cout << "One or both players not found.\n";
         return;
     }
 
-    // Safely dereference the smart pointers
-    auto& player1 = *it1;
-    auto& player2 = *it2;
-
     // Check if either player has already participated in 3 fights
     if (player1->getFights() >= 3 || player2->getFights() >= 3) {
         std::cout << "One or both players have already participated in 3 fights.\n";
@@ -163,17 +176,17 @@ class CombatGameManager {
 
         void outputAllPlayers() {
             for (const auto& player : players) {
-                std::cout << *player << "\n";
+                std::cout << player << "\n";
             }
         }
 
         void outputWinner() {
-            auto winner = std::max_element(players.begin(), players.end(), [](const auto& p1, const auto& p2) {
-                return p1->getFights() < p2->getFights();
+            auto winner = std::max_element(players.begin(), players.end(), [](const Player& p1, const Player& p2) {
+                return p1.getFights() < p2.getFights();
             });
 
             if (winner != players.end()) {
-                std::cout << "Winner: " << **winner << "\n";
+                std::cout << "Winner: " << *winner << "\n";
             } else {
                 std::cout << "No players have participated in fights yet.\n";
             }
@@ -209,8 +222,25 @@ class CombatGameManager {
         }
 };
 
-int main() {
-    CombatGameManager manager;
+const std::size_t DEFAULT_PLAYER_LIMIT = 6;
+const long MAX_PLAYER_LIMIT = 100000;  // Every player slot is reserved up front
+
+// Player limit given on the command line, or the default if it is not a number in 1..MAX_PLAYER_LIMIT
+std::size_t parsePlayerLimit(const char* text) {
+    errno = 0;
+    char* end = nullptr;
+    const long limit = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE || limit < 1 || limit > MAX_PLAYER_LIMIT) {
+        std::cout << "Invalid player limit \"" << text << "\" (expected 1 to " << MAX_PLAYER_LIMIT
+                  << "), using " << DEFAULT_PLAYER_LIMIT << ".\n";
+        return DEFAULT_PLAYER_LIMIT;
+    }
+    return static_cast<std::size_t>(limit);
+}
+
+int main(int argc, char* argv[]) {
+    // Optional argument: the player limit (default 6)
+    CombatGameManager manager(argc > 1 ? parsePlayerLimit(argv[1]) : DEFAULT_PLAYER_LIMIT);
     manager.run();
     return 0;
 }